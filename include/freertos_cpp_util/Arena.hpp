@@ -0,0 +1,292 @@
+/**
+ * @brief Arena bump allocator
+ * @author Jacob Schloss <jacob@schloss.io>
+ * @copyright Copyright (c) 2026 Jacob Schloss. All rights reserved.
+ * @license Licensed under the 3-Clause BSD license. See LICENSE for details
+*/
+
+#pragma once
+
+#include "freertos_cpp_util/object_pool/Slab_allocator.hpp"
+
+#include "common_util/Non_copyable.hpp"
+
+#include <array>
+#include <limits>
+#include <new>
+
+#include <cstddef>
+#include <cstdint>
+
+///
+/// Arena
+///
+/// Bump pointer allocation for scratch memory that all dies together, eg per request temporaries
+/// Allocation is an align and a pointer increment, deallocation is a no-op and reset() reclaims everything
+///
+/// Memory is a caller provided buffer, blocks chained from a Slab_class, or both
+/// Chained blocks are taken when the current block runs out and go back to the Slab_class on reset()
+/// With no chained blocks reset() is O(1)
+///
+/// Not thread safe, an arena belongs to one task at a time
+///
+class Arena : private Non_copyable
+{
+public:
+
+	//allocate from buf only
+	Arena(void* const buf, const size_t size) : Arena(buf, size, nullptr)
+	{
+
+	}
+
+	//allocate from blocks of block_source only
+	explicit Arena(Slab_class_base* const block_source) : Arena(nullptr, 0, block_source)
+	{
+
+	}
+
+	//allocate from buf first, then chain blocks from block_source
+	Arena(void* const buf, const size_t size, Slab_class_base* const block_source) :
+		m_buf(static_cast<uint8_t*>(buf)),
+		m_buf_size(size),
+		m_block_source(block_source),
+		m_chain(nullptr),
+		m_cur(m_buf),
+		m_end(m_buf + size)
+	{
+
+	}
+
+	~Arena()
+	{
+		release_chain();
+	}
+
+	//nullptr if out of memory
+	void* allocate(const size_t size, const size_t align = alignof(std::max_align_t))
+	{
+		void* ptr = bump(size, align);
+		if(ptr == nullptr)
+		{
+			if(!chain_block(size, align))
+			{
+				return nullptr;
+			}
+
+			ptr = bump(size, align);
+		}
+
+		return ptr;
+	}
+
+	//free everything allocated so far
+	//objects are not destroyed, only their memory is reclaimed
+	void reset()
+	{
+		release_chain();
+
+		m_cur = m_buf;
+		m_end = m_buf + m_buf_size;
+	}
+
+	//bytes left in the current block
+	size_t get_bytes_left() const
+	{
+		return size_t(m_end - m_cur);
+	}
+
+protected:
+
+	//header at the start of each chained block
+	struct Block_header
+	{
+		Block_header* next;
+	};
+
+	void* bump(const size_t size, const size_t align)
+	{
+		if(m_cur == nullptr)
+		{
+			return nullptr;
+		}
+
+		const std::uintptr_t align_mask = align - 1U;
+		const std::uintptr_t cur_addr = reinterpret_cast<std::uintptr_t>(m_cur);
+		const std::uintptr_t pad = ((cur_addr + align_mask) & (~align_mask)) - cur_addr;
+
+		if((pad > get_bytes_left()) || (size > (get_bytes_left() - pad)))
+		{
+			return nullptr;
+		}
+
+		uint8_t* const ptr = m_cur + pad;
+		m_cur = ptr + size;
+
+		return ptr;
+	}
+
+	//take a new block from m_block_source large enough for size at align
+	bool chain_block(const size_t size, const size_t align)
+	{
+		if(m_block_source == nullptr)
+		{
+			return false;
+		}
+
+		//worst case padding after the header
+		const size_t block_size = m_block_source->get_block_size();
+		if((size > block_size) || ((block_size - size) < (sizeof(Block_header) + align)))
+		{
+			return false;
+		}
+
+		Block_header* const block = static_cast<Block_header*>(m_block_source->allocate_block(0));
+		if(block == nullptr)
+		{
+			return false;
+		}
+
+		block->next = m_chain;
+		m_chain = block;
+
+		m_cur = reinterpret_cast<uint8_t*>(block) + sizeof(Block_header);
+		m_end = reinterpret_cast<uint8_t*>(block) + block_size;
+
+		return true;
+	}
+
+	void release_chain()
+	{
+		while(m_chain != nullptr)
+		{
+			Block_header* const next = m_chain->next;
+			m_block_source->deallocate_block(m_chain);
+			m_chain = next;
+		}
+	}
+
+	uint8_t* const m_buf;
+	const size_t m_buf_size;
+
+	Slab_class_base* const m_block_source;
+
+	//chained blocks, most recent first
+	Block_header* m_chain;
+
+	//free space of the current block
+	uint8_t* m_cur;
+	uint8_t* m_end;
+};
+
+//raw storage for Arena_static
+template<size_t SIZE>
+struct Arena_storage
+{
+	alignas(std::max_align_t) std::array<uint8_t, SIZE> m_buf;
+};
+
+///
+/// Arena_static
+///
+/// An Arena on SIZE bytes of our own storage, in .bss or on the stack
+///
+template<size_t SIZE>
+class Arena_static : private Arena_storage<SIZE>, public Arena
+{
+public:
+
+	Arena_static() : Arena_static(nullptr)
+	{
+
+	}
+
+	//storage is a base so it is ready before Arena is built on it
+	explicit Arena_static(Slab_class_base* const block_source) : Arena_storage<SIZE>(), Arena(Arena_storage<SIZE>::m_buf.data(), SIZE, block_source)
+	{
+
+	}
+};
+
+///
+/// Arena_allocator
+///
+/// C++11 style allocator on an Arena, for scratch containers
+/// deallocate is a no-op, the memory comes back on Arena::reset()
+/// Running out of arena throws std::bad_alloc like FreeRTOS_allocator
+///
+template<typename T>
+class Arena_allocator
+{
+public:
+	typedef T value_type;
+	typedef T* pointer;
+	typedef const T* const_pointer;
+	typedef T& reference;
+	typedef const T& const_reference;
+	typedef std::size_t size_type;
+	typedef std::ptrdiff_t difference_type;
+
+	explicit Arena_allocator(Arena* const arena) noexcept : m_arena(arena)
+	{
+
+	}
+
+	template<typename U>
+	Arena_allocator(const Arena_allocator<U>& rhs) noexcept : m_arena(rhs.get_arena())
+	{
+
+	}
+
+	template<typename U>
+	struct rebind
+	{
+		typedef Arena_allocator<U> other;
+	};
+
+	size_type max_size() const noexcept
+	{
+		return std::numeric_limits<std::size_t>::max() / sizeof(T);
+	}
+
+	pointer allocate(size_type num)
+	{
+		if(num > max_size())
+		{
+			throw std::bad_alloc();
+		}
+
+		pointer p = static_cast<pointer>(m_arena->allocate(num * sizeof(T), alignof(T)));
+		if(p == nullptr)
+		{
+			throw std::bad_alloc();
+		}
+
+		return p;
+	}
+
+	void deallocate(pointer p, size_type num)
+	{
+
+	}
+
+	Arena* get_arena() const noexcept
+	{
+		return m_arena;
+	}
+
+protected:
+	Arena* m_arena;
+};
+
+template< class T1, class T2 >
+bool operator==(const Arena_allocator<T1>& lhs, const Arena_allocator<T2>& rhs ) noexcept
+{
+	return lhs.get_arena() == rhs.get_arena();
+}
+
+template< class T1, class T2 >
+bool operator!=(const Arena_allocator<T1>& lhs, const Arena_allocator<T2>& rhs ) noexcept
+{
+	return !(lhs == rhs);
+}
@@ -0,0 +1,58 @@
+/**
+ * @brief RAII core local critical section
+ * @author Jacob Schloss <jacob@schloss.io>
+ * @copyright Copyright (c) 2026 Jacob Schloss. All rights reserved.
+ * @license Licensed under the 3-Clause BSD license. See LICENSE for details
+*/
+
+#pragma once
+
+#include "common_util/Non_copyable.hpp"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include <cstddef>
+
+///
+/// Core_local_section
+///
+/// Masks interrupts on the calling core only, usable from a task or an isr
+/// The running task can not be preempted or migrated, but other cores keep running
+/// On SMP this does not take the kernel lock, so it only protects per-core data
+///
+class Core_local_section : private Non_copyable
+{
+public:
+	Core_local_section()
+	{
+		m_mask = portSET_INTERRUPT_MASK_FROM_ISR();
+	}
+
+	~Core_local_section()
+	{
+		portCLEAR_INTERRUPT_MASK_FROM_ISR(m_mask);
+	}
+
+	//only stable while a Core_local_section is held
+	static size_t get_core_id()
+	{
+#if defined(configNUMBER_OF_CORES) && (configNUMBER_OF_CORES > 1)
+		return portGET_CORE_ID();
+#else
+		return 0;
+#endif
+	}
+
+	static constexpr size_t get_num_cores()
+	{
+#if defined(configNUMBER_OF_CORES)
+		return configNUMBER_OF_CORES;
+#else
+		return 1;
+#endif
+	}
+
+protected:
+	UBaseType_t m_mask;
+};
@@ -12,9 +12,39 @@
 #include <limits>
 #include <new>
 
+#include "freertos_cpp_util/Heap_accounting.hpp"
+
 #include "FreeRTOS.h"
 
-template<typename T>
+///
+/// FreeRTOS_heap
+///
+/// Default FreeRTOS_allocator heap, pvPortMalloc and vPortFree
+/// Counted per task with FREERTOS_CPP_UTIL_HEAP_ACCOUNTING
+/// See Heap_cache.hpp for a size class cached heap
+///
+struct FreeRTOS_heap
+{
+	static void* allocate(const size_t size)
+	{
+#if FREERTOS_CPP_UTIL_HEAP_ACCOUNTING
+		return Heap_accounting::allocate(size);
+#else
+		return pvPortMalloc(size);
+#endif
+	}
+
+	static void deallocate(void* const ptr, const size_t)
+	{
+#if FREERTOS_CPP_UTIL_HEAP_ACCOUNTING
+		Heap_accounting::deallocate(ptr);
+#else
+		vPortFree(ptr);
+#endif
+	}
+};
+
+template<typename T, typename Heap = FreeRTOS_heap>
 class FreeRTOS_allocator
 {
 public:
@@ -37,7 +67,7 @@ public:
 	}
 
 	template<typename U>
-	FreeRTOS_allocator(const FreeRTOS_allocator<U>& rhs) noexcept
+	FreeRTOS_allocator(const FreeRTOS_allocator<U, Heap>& rhs) noexcept
 	{
 		
 	}
@@ -50,7 +80,7 @@ public:
 	template<typename U>
 	struct rebind
 	{
-		typedef FreeRTOS_allocator<U> other;
+		typedef FreeRTOS_allocator<U, Heap> other;
 	};
 
 	pointer address(reference val) const noexcept
@@ -75,13 +105,18 @@ public:
 	}
 
 	//c++11 style
-	pointer allocate(size_type num, const void* hint = 0)
+	pointer allocate(size_type num, const void* hint)
 	{
+		if(num > max_size())
+		{
+			throw std::bad_alloc();
+		}
+
 		pointer p = nullptr;
 		if(alignof(T) <= portBYTE_ALIGNMENT)
 		{
 			//default alignment
-			p = pvPortMalloc(num * sizeof(T));
+			p = static_cast<pointer>(Heap::allocate(num * sizeof(T)));
 
 			if(p == nullptr)
 			{
@@ -95,7 +130,7 @@ public:
 			constexpr std::uintptr_t allignment_mask = alignof(T) - 1U;
 
 			// constexpr size_t req_allign = alignof(T);
-			pointer raw_p = pvPortMalloc(num * sizeof(T) + allignment);
+			void* raw_p = Heap::allocate(num * sizeof(T) + allignment);
 
 			if(raw_p == nullptr)
 			{
@@ -133,26 +168,26 @@ public:
 		if(alignof(T) <= portBYTE_ALIGNMENT)
 		{
 			//default alignment
-			vPortFree(p);
+			Heap::deallocate(p, num * sizeof(T));
 		}
 		else
 		{
 			//wider alignment, we stashed the real heap pointer here
-			pointer start = static_cast<pointer>( *(reinterpret_cast<void**>(p) - 1) );
-			vPortFree(start);
+			void* start = *(reinterpret_cast<void**>(p) - 1);
+			Heap::deallocate(start, num * sizeof(T) + alignof(T));
 		}
 	}
 
 };
 
-template< class T1, class T2 >
-bool operator==(const FreeRTOS_allocator<T1>& lhs, const FreeRTOS_allocator<T2>& rhs ) noexcept
+template< class T1, class T2, class Heap >
+bool operator==(const FreeRTOS_allocator<T1, Heap>& lhs, const FreeRTOS_allocator<T2, Heap>& rhs ) noexcept
 {
 	return true;
 }
 
-template< class T1, class T2 >
-bool operator!=(const FreeRTOS_allocator<T1>& lhs, const FreeRTOS_allocator<T2>& rhs ) noexcept
+template< class T1, class T2, class Heap >
+bool operator!=(const FreeRTOS_allocator<T1, Heap>& lhs, const FreeRTOS_allocator<T2, Heap>& rhs ) noexcept
 {
 	return false;
 }
@@ -0,0 +1,95 @@
+/**
+ * @brief Per-task heap accounting
+ * @author Jacob Schloss <jacob@schloss.io>
+ * @copyright Copyright (c) 2026 Jacob Schloss. All rights reserved.
+ * @license Licensed under the 3-Clause BSD license. See LICENSE for details
+*/
+
+#pragma once
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include <array>
+
+#include <cstddef>
+#include <cstdint>
+
+//define to 1 to count heap use per task through FreeRTOS_allocator and global new / delete
+//off by default, each allocation then carries a small header and a short critical section
+//the header must match between the library and its users, so set it with the FREERTOS_CPP_UTIL_HEAP_ACCOUNTING cmake option
+#ifndef FREERTOS_CPP_UTIL_HEAP_ACCOUNTING
+#define FREERTOS_CPP_UTIL_HEAP_ACCOUNTING 0
+#endif
+
+//set to 0 to keep accounting for FreeRTOS_allocator but leave global new / delete to the application
+//cmake option FREERTOS_CPP_UTIL_HEAP_ACCOUNTING_NEW
+#ifndef FREERTOS_CPP_UTIL_HEAP_ACCOUNTING_NEW
+#define FREERTOS_CPP_UTIL_HEAP_ACCOUNTING_NEW FREERTOS_CPP_UTIL_HEAP_ACCOUNTING
+#endif
+
+//number of tasks tracked, later tasks are counted in the shared other slot
+#ifndef FREERTOS_CPP_UTIL_HEAP_ACCOUNTING_MAX_TASKS
+#define FREERTOS_CPP_UTIL_HEAP_ACCOUNTING_MAX_TASKS 16
+#endif
+
+struct Heap_task_stats
+{
+	TaskHandle_t task;
+
+	size_t bytes;
+	size_t peak_bytes;
+
+	uint32_t alloc_count;
+};
+
+///
+/// Heap_accounting
+///
+/// pvPortMalloc / vPortFree with bytes in use, peak bytes and allocation count kept per task
+/// Tasks are kept in a handle keyed table, claimed on their first allocation
+/// Each block records its owning slot, so memory freed by another task is credited back to the allocating task
+/// Allocations before the scheduler starts, or with the table full, go to the other slot
+///
+/// The table is constant initialized, so it is usable from global new during static init
+/// Before the scheduler starts there is one thread, so the table is updated without a critical section
+///
+class Heap_accounting
+{
+public:
+
+	static constexpr size_t MAX_TASKS = FREERTOS_CPP_UTIL_HEAP_ACCOUNTING_MAX_TASKS;
+
+	static void* allocate(const size_t size);
+
+	//ptr must come from allocate
+	static void deallocate(void* const ptr);
+
+	//false if task has no slot
+	static bool get_task_stats(const TaskHandle_t task, Heap_task_stats* const out_stats);
+
+	//allocations not tied to a tracked task, including bytes still held by deleted tasks
+	static Heap_task_stats get_other_stats();
+
+	//move the counts of a deleted task to the other slot, so its handle can be reused
+	//Task_base does this on destruction, call it yourself for tasks deleted with vTaskDelete directly
+	static void forget_task(const TaskHandle_t task);
+
+protected:
+
+	static constexpr size_t OTHER_SLOT = MAX_TASKS;
+
+	struct Alloc_header
+	{
+		size_t size;
+		size_t slot;
+	};
+
+	//keep the user block at heap alignment
+	static constexpr size_t HEADER_SIZE = (sizeof(Alloc_header) + portBYTE_ALIGNMENT - 1U) & ~size_t(portBYTE_ALIGNMENT - 1U);
+
+	//call in a critical section
+	static size_t find_slot(const TaskHandle_t task);
+
+	static std::array<Heap_task_stats, MAX_TASKS + 1> m_table;
+};
@@ -0,0 +1,195 @@
+/**
+ * @brief Size class cache in front of the FreeRTOS heap
+ * @author Jacob Schloss <jacob@schloss.io>
+ * @copyright Copyright (c) 2026 Jacob Schloss. All rights reserved.
+ * @license Licensed under the 3-Clause BSD license. See LICENSE for details
+*/
+
+#pragma once
+
+#include "freertos_cpp_util/FreeRTOS_allocator.hpp"
+#include "freertos_cpp_util/Critical_section.hpp"
+
+#include "common_util/Non_copyable.hpp"
+
+#include "FreeRTOS.h"
+
+#include <array>
+
+#include <cstddef>
+#include <cstdint>
+
+//bytes taken from pvPortMalloc per refill of a size class
+#ifndef FREERTOS_CPP_UTIL_HEAP_CACHE_CHUNK_SIZE
+#define FREERTOS_CPP_UTIL_HEAP_CACHE_CHUNK_SIZE 1024
+#endif
+
+///
+/// Heap_cache
+///
+/// Power of 2 size classes, each with an intrusive free list refilled in chunks from pvPortMalloc
+/// A request that fits a class is a free list pop in a short critical section, no heap walk and no scheduler suspension
+/// Freed blocks go back to their class, not to the heap, so each class holds on to its peak use
+/// Larger requests go straight to pvPortMalloc
+///
+/// Blocks do not carry a header, the caller passes the request size back to deallocate
+///
+class Heap_cache : private Non_copyable
+{
+public:
+
+	static constexpr size_t NUM_CLASSES = 6;
+	static constexpr size_t MIN_BLOCK_SIZE = 16;
+	static constexpr size_t CHUNK_SIZE = FREERTOS_CPP_UTIL_HEAP_CACHE_CHUNK_SIZE;
+
+	//block size of a class, a multiple of portBYTE_ALIGNMENT so every block keeps heap alignment
+	static constexpr size_t get_class_size(const size_t idx)
+	{
+		return ((MIN_BLOCK_SIZE << idx) + portBYTE_ALIGNMENT - 1U) & ~size_t(portBYTE_ALIGNMENT - 1U);
+	}
+
+	static_assert(MIN_BLOCK_SIZE >= sizeof(void*), "blocks must hold the free list link");
+
+	//shared instance used by FreeRTOS_heap_cached
+	static Heap_cache* get_instance();
+
+	Heap_cache() : m_free_list(), m_chunk_bytes(0)
+	{
+		static_assert(CHUNK_SIZE >= get_class_size(NUM_CLASSES - 1), "a chunk must hold at least one block of every class");
+	}
+
+	void* allocate(const size_t size)
+	{
+		const size_t idx = find_class(size);
+		if(idx == NUM_CLASSES)
+		{
+			return pvPortMalloc(size);
+		}
+
+		{
+			Critical_section lock;
+
+			Free_block* const block = m_free_list[idx];
+			if(block != nullptr)
+			{
+				m_free_list[idx] = block->next;
+				return block;
+			}
+		}
+
+		return refill(idx);
+	}
+
+	//size must be the size passed to allocate
+	void deallocate(void* const ptr, const size_t size)
+	{
+		if(ptr == nullptr)
+		{
+			return;
+		}
+
+		const size_t idx = find_class(size);
+		if(idx == NUM_CLASSES)
+		{
+			vPortFree(ptr);
+			return;
+		}
+
+		Free_block* const block = static_cast<Free_block*>(ptr);
+
+		Critical_section lock;
+		block->next = m_free_list[idx];
+		m_free_list[idx] = block;
+	}
+
+	//bytes held from the heap by the size classes, in use or cached
+	size_t get_chunk_bytes() const
+	{
+		Critical_section lock;
+		return m_chunk_bytes;
+	}
+
+protected:
+
+	struct Free_block
+	{
+		Free_block* next;
+	};
+
+	//smallest class that fits, NUM_CLASSES if none
+	static size_t find_class(const size_t size)
+	{
+		for(size_t i = 0; i < NUM_CLASSES; i++)
+		{
+			if(size <= get_class_size(i))
+			{
+				return i;
+			}
+		}
+
+		return NUM_CLASSES;
+	}
+
+	//carve a new chunk into blocks of class idx, keep one and cache the rest
+	void* refill(const size_t idx)
+	{
+		const size_t block_size = get_class_size(idx);
+		const size_t num_blocks = CHUNK_SIZE / block_size;
+
+		uint8_t* const chunk = static_cast<uint8_t*>(pvPortMalloc(num_blocks * block_size));
+		if(chunk == nullptr)
+		{
+			return nullptr;
+		}
+
+		//link blocks 1..n-1, block 0 is returned
+		Free_block* const first = reinterpret_cast<Free_block*>(chunk + block_size);
+		Free_block* last = first;
+		for(size_t i = 2; i < num_blocks; i++)
+		{
+			Free_block* const block = reinterpret_cast<Free_block*>(chunk + i * block_size);
+			last->next = block;
+			last = block;
+		}
+
+		{
+			Critical_section lock;
+
+			if(num_blocks > 1)
+			{
+				last->next = m_free_list[idx];
+				m_free_list[idx] = first;
+			}
+
+			m_chunk_bytes += num_blocks * block_size;
+		}
+
+		return chunk;
+	}
+
+	std::array<Free_block*, NUM_CLASSES> m_free_list;
+
+	size_t m_chunk_bytes;
+};
+
+///
+/// FreeRTOS_heap_cached
+///
+/// FreeRTOS_allocator heap that goes through the shared Heap_cache
+///
+struct FreeRTOS_heap_cached
+{
+	static void* allocate(const size_t size)
+	{
+		return Heap_cache::get_instance()->allocate(size);
+	}
+
+	static void deallocate(void* const ptr, const size_t size)
+	{
+		Heap_cache::get_instance()->deallocate(ptr, size);
+	}
+};
+
+//FreeRTOS_allocator with repeated same size allocations served from the Heap_cache
+template<typename T>
+using FreeRTOS_cached_allocator = FreeRTOS_allocator<T, FreeRTOS_heap_cached>;
@@ -0,0 +1,102 @@
+/**
+ * @brief FreeRTOS heap fragmentation statistics
+ * @author Jacob Schloss <jacob@schloss.io>
+ * @copyright Copyright (c) 2026 Jacob Schloss. All rights reserved.
+ * @license Licensed under the 3-Clause BSD license. See LICENSE for details
+*/
+
+#pragma once
+
+#include "FreeRTOS.h"
+
+#include <array>
+#include <functional>
+
+#include <cstddef>
+#include <cstdint>
+
+///
+/// Heap_frag_snapshot
+///
+/// Free space of the FreeRTOS heap at one point in time
+/// The size histogram is only filled in when a heap walk is available, see Heap_frag_stats::Heap_walk_func
+///
+struct Heap_frag_snapshot
+{
+	//free blocks in [64 << (i-1), 64 << i), the first bin is below 64 and the last is open ended
+	static constexpr size_t NUM_BINS = 8;
+	static constexpr size_t MIN_BIN_SIZE = 64;
+
+	size_t free_bytes;
+	size_t min_ever_free_bytes;
+
+	size_t largest_free_block;
+	size_t smallest_free_block;
+	size_t num_free_blocks;
+
+	bool has_histogram;
+	std::array<uint32_t, NUM_BINS> histogram;
+
+	//0 for one contiguous free block, approaches 1 as free space splinters
+	float frag_index;
+};
+
+///
+/// Heap_frag_stats
+///
+/// Fragmentation analysis on top of vPortGetHeapStats, with a trend over recent snapshots
+///
+class Heap_frag_stats
+{
+public:
+
+	//snapshots kept for the trend
+	static constexpr size_t HISTORY_LEN = 8;
+
+	//the heap implementation walks its free list and calls on_free_block with the size of each free block
+	//eg in heap_4.c, from xStart under vTaskSuspendAll()
+	typedef std::function<void(const std::function<void(size_t)>& on_free_block)> Heap_walk_func;
+
+	Heap_frag_stats() : m_history(), m_history_len(0), m_history_next(0)
+	{
+
+	}
+
+	void set_heap_walk_handler(const Heap_walk_func& walk)
+	{
+		m_heap_walk = walk;
+	}
+
+	//read the heap and add the result to the trend
+	void update();
+
+	//most recent snapshot, update() must have been called
+	const Heap_frag_snapshot& get_latest() const;
+
+	//oldest snapshot still in the trend window, update() must have been called
+	const Heap_frag_snapshot& get_oldest() const;
+
+	//number of snapshots in the trend window
+	size_t get_history_len() const
+	{
+		return m_history_len;
+	}
+
+	static void get_snapshot(Heap_frag_snapshot* const out_snap, const Heap_walk_func& walk);
+
+	static size_t get_bin(const size_t block_size);
+
+	//lower bound of a histogram bin
+	static size_t get_bin_min(const size_t bin)
+	{
+		return (bin == 0) ? 0 : (Heap_frag_snapshot::MIN_BIN_SIZE << (bin - 1));
+	}
+
+protected:
+
+	Heap_walk_func m_heap_walk;
+
+	std::array<Heap_frag_snapshot, HISTORY_LEN> m_history;
+	size_t m_history_len;
+	size_t m_history_next;
+};
@@ -0,0 +1,137 @@
+/**
+ * @brief Stack allocated latest-value mailbox for POD objects
+ * @author Jacob Schloss <jacob@schloss.io>
+ * @copyright Copyright (c) 2026 Jacob Schloss. All rights reserved.
+ * @license Licensed under the 3-Clause BSD license. See LICENSE for details
+*/
+
+#pragma once
+
+#include "freertos_cpp_util/Queue_base.hpp"
+
+#include <array>
+#include <chrono>
+#include <type_traits>
+
+///
+/// Mailbox_static
+///
+/// Holds only the newest value, a length 1 queue written with xQueueOverwrite
+/// Writers never block, readers may peek without removing the value
+/// With FREERTOS_CPP_UTIL_QUEUE_STATS, writes count as pushes and reads as pops, peeks are not counted
+///
+template<typename T>
+class Mailbox_static : public Queue_handle
+{
+public:
+
+	static_assert(std::is_pod<T>::value, "T must be POD");
+
+	Mailbox_static()
+	{
+		m_queue_buf = {0};
+
+		this->m_queue = xQueueCreateStatic(1, sizeof(T), reinterpret_cast<uint8_t*>(m_buf.data()), &m_queue_buf);
+	}
+
+	~Mailbox_static()
+	{
+
+	}
+
+	//replaces any value already posted
+	void write(const T& item)
+	{
+		xQueueOverwrite(m_queue, &item);
+
+		this->stats_push(true, m_queue, 0, 0);
+	}
+
+	void write_isr(const T& item)
+	{
+		BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+		write_isr(item, &xHigherPriorityTaskWoken);
+
+		portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+	}
+
+	void write_isr(const T& item, BaseType_t* const pxHigherPriorityTaskWoken)
+	{
+		xQueueOverwriteFromISR(m_queue, &item, pxHigherPriorityTaskWoken);
+
+		this->stats_push_isr(true, m_queue);
+	}
+
+	//copy the value out and leave it posted
+	bool peek(T* const item)
+	{
+		return peek(item, 0);
+	}
+
+	bool peek(T* const item, const TickType_t xTicksToWait)
+	{
+		return pdTRUE == xQueuePeek(m_queue, item, xTicksToWait);
+	}
+
+	template< class Rep, class Period >
+	bool peek(T* const item, const std::chrono::duration<Rep,Period>& duration)
+	{
+		const std::chrono::milliseconds duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+		return peek(item, pdMS_TO_TICKS(duration_ms.count()));
+	}
+
+	bool peek_isr(T* const item)
+	{
+		return pdTRUE == xQueuePeekFromISR(m_queue, item);
+	}
+
+	//copy the value out and clear the mailbox
+	bool read(T* const item)
+	{
+		return read(item, 0);
+	}
+
+	bool read(T* const item, const TickType_t xTicksToWait)
+	{
+		const TickType_t start = this->stats_start(xTicksToWait);
+
+		const bool ret = pdTRUE == xQueueReceive(m_queue, item, xTicksToWait);
+
+		this->stats_pop(ret, xTicksToWait, start);
+
+		return ret;
+	}
+
+	template< class Rep, class Period >
+	bool read(T* const item, const std::chrono::duration<Rep,Period>& duration)
+	{
+		const std::chrono::milliseconds duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+		return read(item, pdMS_TO_TICKS(duration_ms.count()));
+	}
+
+	bool read_isr(T* const item)
+	{
+		BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+		const bool ret = read_isr(item, &xHigherPriorityTaskWoken);
+
+		portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+
+		return ret;
+	}
+
+	bool read_isr(T* const item, BaseType_t* const pxHigherPriorityTaskWoken)
+	{
+		const bool ret = pdTRUE == xQueueReceiveFromISR(m_queue, item, pxHigherPriorityTaskWoken);
+
+		this->stats_pop_isr(ret);
+
+		return ret;
+	}
+
+protected:
+	StaticQueue_t m_queue_buf;
+
+	std::array<T, 1> m_buf;
+};
@@ -0,0 +1,112 @@
+/**
+ * @brief std::pmr memory resources for FreeRTOS
+ * @author Jacob Schloss <jacob@schloss.io>
+ * @copyright Copyright (c) 2026 Jacob Schloss. All rights reserved.
+ * @license Licensed under the 3-Clause BSD license. See LICENSE for details
+*/
+
+#pragma once
+
+#include "FreeRTOS.h"
+
+#include <array>
+#include <memory_resource>
+#include <new>
+
+#include <cstddef>
+#include <cstdint>
+
+///
+/// FreeRTOS_memory_resource
+///
+/// A std::pmr::memory_resource on pvPortMalloc, the pmr counterpart of FreeRTOS_allocator
+/// Wider than portBYTE_ALIGNMENT requests are over allocated and the heap pointer stashed in front
+///
+class FreeRTOS_memory_resource : public std::pmr::memory_resource
+{
+public:
+
+	//shared instance, like std::pmr::new_delete_resource
+	static FreeRTOS_memory_resource* get_instance();
+
+protected:
+
+	void* do_allocate(std::size_t bytes, std::size_t alignment) override
+	{
+		if(alignment <= portBYTE_ALIGNMENT)
+		{
+			void* const p = pvPortMalloc(bytes);
+			if(p == nullptr)
+			{
+				throw std::bad_alloc();
+			}
+
+			return p;
+		}
+
+		//wider alignment, room to align and to stash the real heap pointer
+		void* const raw_p = pvPortMalloc(bytes + alignment + sizeof(void*));
+		if(raw_p == nullptr)
+		{
+			throw std::bad_alloc();
+		}
+
+		const std::uintptr_t alignment_mask = alignment - 1U;
+		const std::uintptr_t raw_addr = reinterpret_cast<std::uintptr_t>(raw_p) + sizeof(void*);
+
+		void* const p = reinterpret_cast<void*>((raw_addr + alignment_mask) & (~alignment_mask));
+
+		*(reinterpret_cast<void**>(p) - 1) = raw_p;
+
+		return p;
+	}
+
+	void do_deallocate(void* p, std::size_t, std::size_t alignment) override
+	{
+		if(alignment <= portBYTE_ALIGNMENT)
+		{
+			vPortFree(p);
+		}
+		else
+		{
+			vPortFree(*(reinterpret_cast<void**>(p) - 1));
+		}
+	}
+
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+	{
+		//no rtti on most targets, use get_instance() so there is only one
+		return this == &other;
+	}
+};
+
+//raw storage for Monotonic_buffer_resource_static
+template<size_t SIZE>
+struct Monotonic_buffer_storage
+{
+	alignas(std::max_align_t) std::array<uint8_t, SIZE> m_buf;
+};
+
+///
+/// Monotonic_buffer_resource_static
+///
+/// A std::pmr::monotonic_buffer_resource on SIZE bytes of our own storage, in .bss or on the stack
+/// Deallocation is a no-op, release() reclaims everything at once
+/// With the default upstream, running out throws std::bad_alloc instead of falling back to a heap
+///
+template<size_t SIZE>
+class Monotonic_buffer_resource_static : private Monotonic_buffer_storage<SIZE>, public std::pmr::monotonic_buffer_resource
+{
+public:
+
+	Monotonic_buffer_resource_static() : Monotonic_buffer_resource_static(std::pmr::null_memory_resource())
+	{
+
+	}
+
+	//storage is a base so it is ready before monotonic_buffer_resource is built on it
+	explicit Monotonic_buffer_resource_static(std::pmr::memory_resource* const upstream) : Monotonic_buffer_storage<SIZE>(), std::pmr::monotonic_buffer_resource(this->m_buf.data(), SIZE, upstream)
+	{
+
+	}
+};
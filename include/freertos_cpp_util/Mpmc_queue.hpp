@@ -0,0 +1,377 @@
+/**
+ * @brief Lock-free bounded multi producer multi consumer queue for POD objects
+ * @author Jacob Schloss <jacob@schloss.io>
+ * @copyright Copyright (c) 2026 Jacob Schloss. All rights reserved.
+ * @license Licensed under the 3-Clause BSD license. See LICENSE for details
+*/
+
+#pragma once
+
+#include "freertos_cpp_util/CSema_static.hpp"
+
+#include "common_util/Non_copyable.hpp"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <type_traits>
+
+#include <cstdint>
+
+///
+/// Mpmc_queue
+///
+/// Bounded array of sequence numbered cells (D. Vyukov's MPMC queue)
+/// Producers and consumers on different cores only contend on a CAS of their own position counter
+/// Same push_back / pop_front / isr interface as Queue_template_base, without a kernel queue
+///
+/// Tasks block on a counting semaphore only when the queue is full or empty
+/// The semaphore is only given if someone is waiting, so the common path never enters the kernel
+///
+template<typename T, size_t LEN>
+class Mpmc_queue : private Non_copyable
+{
+public:
+
+	static_assert(std::is_pod<T>::value, "T must be POD");
+	static_assert((LEN >= 2) && ((LEN & (LEN - 1)) == 0), "LEN must be a power of 2");
+
+	Mpmc_queue() : m_enqueue_pos(0), m_dequeue_pos(0), m_pop_waiters(0), m_push_waiters(0), m_pop_sema(LEN, 0), m_push_sema(LEN, 0)
+	{
+		for(size_t i = 0; i < LEN; i++)
+		{
+			m_buf[i].seq.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	//approximate if there are concurrent users
+	size_t size() const
+	{
+		const size_t enq = m_enqueue_pos.load(std::memory_order_acquire);
+		const size_t deq = m_dequeue_pos.load(std::memory_order_acquire);
+
+		const size_t diff = enq - deq;
+		return (diff > LEN) ? 0 : diff;
+	}
+
+	size_t reserve() const
+	{
+		return LEN - size();
+	}
+
+	size_t capacity() const
+	{
+		return LEN;
+	}
+
+	bool full() const
+	{
+		return size() == LEN;
+	}
+
+	bool empty() const
+	{
+		return size() == 0;
+	}
+
+	bool pop_front(T* const item)
+	{
+		return pop_front(item, 0);
+	}
+
+	bool pop_front_wait(T* const item, const bool wait)
+	{
+		bool ret = false;
+
+		if(wait)
+		{
+			do
+			{
+				ret = pop_front(item, portMAX_DELAY);
+			} while(ret != true);
+		}
+		else
+		{
+			ret = pop_front(item, 0);
+		}
+
+		return ret;
+	}
+
+	bool pop_front(T* const item, const TickType_t xTicksToWait)
+	{
+		if(try_pop(item))
+		{
+			wake(&m_push_waiters, &m_push_sema);
+			return true;
+		}
+
+		if(xTicksToWait == 0)
+		{
+			return false;
+		}
+
+		if(!wait_for(&m_pop_waiters, &m_pop_sema, xTicksToWait, [this, item](){return try_pop(item);}))
+		{
+			return false;
+		}
+
+		wake(&m_push_waiters, &m_push_sema);
+		return true;
+	}
+
+	template< class Rep, class Period >
+	bool pop_front(T* const item, const std::chrono::duration<Rep,Period>& duration)
+	{
+		const std::chrono::milliseconds duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+		return pop_front(item, pdMS_TO_TICKS(duration_ms.count()));
+	}
+
+	bool pop_front_isr(T* const item)
+	{
+		BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+		const bool ret = pop_front_isr(item, &xHigherPriorityTaskWoken);
+
+		portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+
+		return ret;
+	}
+
+	bool pop_front_isr(T* const item, BaseType_t* const pxHigherPriorityTaskWoken)
+	{
+		if(!try_pop(item))
+		{
+			return false;
+		}
+
+		wake_isr(&m_push_waiters, &m_push_sema, pxHigherPriorityTaskWoken);
+		return true;
+	}
+
+	bool push_back(const T& item)
+	{
+		return push_back(item, 0);
+	}
+
+	bool push_back_wait(const T& item, const bool wait)
+	{
+		bool ret = false;
+
+		if(wait)
+		{
+			do
+			{
+				ret = push_back(item, portMAX_DELAY);
+			} while(ret != true);
+		}
+		else
+		{
+			ret = push_back(item, 0);
+		}
+
+		return ret;
+	}
+
+	bool push_back(const T& item, const TickType_t xTicksToWait)
+	{
+		if(try_push(item))
+		{
+			wake(&m_pop_waiters, &m_pop_sema);
+			return true;
+		}
+
+		if(xTicksToWait == 0)
+		{
+			return false;
+		}
+
+		if(!wait_for(&m_push_waiters, &m_push_sema, xTicksToWait, [this, &item](){return try_push(item);}))
+		{
+			return false;
+		}
+
+		wake(&m_pop_waiters, &m_pop_sema);
+		return true;
+	}
+
+	template< class Rep, class Period >
+	bool push_back(const T& item, const std::chrono::duration<Rep,Period>& duration)
+	{
+		const std::chrono::milliseconds duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+		return push_back(item, pdMS_TO_TICKS(duration_ms.count()));
+	}
+
+	bool push_back_isr(const T& item)
+	{
+		BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+		const bool ret = push_back_isr(item, &xHigherPriorityTaskWoken);
+
+		portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+
+		return ret;
+	}
+
+	bool push_back_isr(const T& item, BaseType_t* const pxHigherPriorityTaskWoken)
+	{
+		if(!try_push(item))
+		{
+			return false;
+		}
+
+		wake_isr(&m_pop_waiters, &m_pop_sema, pxHigherPriorityTaskWoken);
+		return true;
+	}
+
+protected:
+
+	static constexpr size_t MASK = LEN - 1;
+
+	//keep the hot counters on their own cache lines
+	static constexpr size_t CACHE_LINE_SIZE = 64;
+
+	struct Cell
+	{
+		std::atomic<size_t> seq;
+		T data;
+	};
+
+	bool try_push(const T& item)
+	{
+		size_t pos = m_enqueue_pos.load(std::memory_order_relaxed);
+		for(;;)
+		{
+			Cell* const cell = &m_buf[pos & MASK];
+			const size_t seq = cell->seq.load(std::memory_order_acquire);
+			const intptr_t diff = intptr_t(seq) - intptr_t(pos);
+
+			if(diff == 0)
+			{
+				if(m_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				{
+					cell->data = item;
+
+					//seq_cst, ordered before the waiter check in wake
+					cell->seq.store(pos + 1, std::memory_order_seq_cst);
+					return true;
+				}
+			}
+			else if(diff < 0)
+			{
+				//full
+				return false;
+			}
+			else
+			{
+				pos = m_enqueue_pos.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	bool try_pop(T* const item)
+	{
+		size_t pos = m_dequeue_pos.load(std::memory_order_relaxed);
+		for(;;)
+		{
+			Cell* const cell = &m_buf[pos & MASK];
+			const size_t seq = cell->seq.load(std::memory_order_acquire);
+			const intptr_t diff = intptr_t(seq) - intptr_t(pos + 1);
+
+			if(diff == 0)
+			{
+				if(m_dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				{
+					*item = cell->data;
+
+					//seq_cst, ordered before the waiter check in wake
+					cell->seq.store(pos + MASK + 1, std::memory_order_seq_cst);
+					return true;
+				}
+			}
+			else if(diff < 0)
+			{
+				//empty
+				return false;
+			}
+			else
+			{
+				pos = m_dequeue_pos.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	//only enter the kernel if someone is blocked on the other side
+	static void wake(std::atomic<size_t>* const waiters, CSema_static* const sema)
+	{
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		if(waiters->load(std::memory_order_seq_cst) != 0)
+		{
+			sema->give();
+		}
+	}
+
+	static void wake_isr(std::atomic<size_t>* const waiters, CSema_static* const sema, BaseType_t* const pxHigherPriorityTaskWoken)
+	{
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		if(waiters->load(std::memory_order_seq_cst) != 0)
+		{
+			sema->give_from_isr(pxHigherPriorityTaskWoken);
+		}
+	}
+
+	//count ourself as waiting, then retry before sleeping so a racing give is not lost
+	//a stale token only causes a spurious wakeup and another retry
+	template<typename Try>
+	static bool wait_for(std::atomic<size_t>* const waiters, CSema_static* const sema, const TickType_t xTicksToWait, const Try& try_op)
+	{
+		TickType_t ticks_left = xTicksToWait;
+		TimeOut_t xTimeOut;
+		vTaskSetTimeOutState(&xTimeOut);
+
+		bool ret = false;
+
+		waiters->fetch_add(1, std::memory_order_seq_cst);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		for(;;)
+		{
+			if(try_op())
+			{
+				ret = true;
+				break;
+			}
+
+			sema->try_take_for_ticks(ticks_left);
+
+			if(try_op())
+			{
+				ret = true;
+				break;
+			}
+
+			if(pdFALSE != xTaskCheckForTimeOut(&xTimeOut, &ticks_left))
+			{
+				break;
+			}
+		}
+		waiters->fetch_sub(1, std::memory_order_seq_cst);
+
+		return ret;
+	}
+
+	std::array<Cell, LEN> m_buf;
+
+	alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_enqueue_pos;
+	alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_dequeue_pos;
+
+	alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_pop_waiters;
+	std::atomic<size_t> m_push_waiters;
+
+	CSema_static m_pop_sema;
+	CSema_static m_push_sema;
+};
@@ -0,0 +1,358 @@
+/**
+ * @brief Stack allocated priority queue class for full C++ objects
+ * @author Jacob Schloss <jacob@schloss.io>
+ * @copyright Copyright (c) 2026 Jacob Schloss. All rights reserved.
+ * @license Licensed under the 3-Clause BSD license. See LICENSE for details
+*/
+
+#pragma once
+
+#include "freertos_cpp_util/CSema_static.hpp"
+#include "freertos_cpp_util/Critical_section.hpp"
+#include "freertos_cpp_util/Critical_section_isr.hpp"
+#include "freertos_cpp_util/object_pool/Object_pool.hpp"
+
+#include "common_util/Non_copyable.hpp"
+
+#include <array>
+#include <chrono>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+///
+/// Priority_queue_static
+///
+/// Elements live in an Object_pool, ordered by a binary heap of pointers
+/// Like std::priority_queue, the greatest element under Compare is popped first, use std::greater for a min-queue
+///
+/// Push blocks on a free pool node, pop blocks on a counting semaphore of queued items
+/// The heap is reordered in a critical section, so Compare should be cheap
+///
+template<typename T, size_t LEN, typename Compare = std::less<T>>
+class Priority_queue_static : private Non_copyable
+{
+public:
+
+	typedef typename Object_pool<T, LEN>::unique_node_ptr unique_node_ptr;
+
+	Priority_queue_static() : m_num_items(LEN, 0), m_heap_size(0)
+	{
+
+	}
+
+	explicit Priority_queue_static(const Compare& comp) : m_num_items(LEN, 0), m_heap_size(0), m_comp(comp)
+	{
+
+	}
+
+	~Priority_queue_static()
+	{
+		for(size_t i = 0; i < m_heap_size; i++)
+		{
+			m_pool.deallocate(m_heap[i]);
+		}
+		m_heap_size = 0;
+	}
+
+	size_t size() const
+	{
+		return m_num_items.get_count();
+	}
+
+	bool empty() const
+	{
+		return size() == 0;
+	}
+
+	bool full() const
+	{
+		return size() == LEN;
+	}
+
+	bool pop_front(T* const item)
+	{
+		return pop_front(item, 0);
+	}
+
+	bool pop_front_wait(T* const item, const bool wait)
+	{
+		bool ret = false;
+
+		if(wait)
+		{
+			do
+			{
+				ret = pop_front(item, portMAX_DELAY);
+			} while(ret != true);
+		}
+		else
+		{
+			ret = pop_front(item, 0);
+		}
+
+		return ret;
+	}
+
+	bool pop_front(T* const item, const TickType_t xTicksToWait)
+	{
+		unique_node_ptr ptr = pop_front_ptr(xTicksToWait);
+		if(!ptr)
+		{
+			return false;
+		}
+
+		*item = std::move(*ptr);
+
+		return true;
+	}
+
+	template< class Rep, class Period >
+	bool pop_front(T* const item, const std::chrono::duration<Rep,Period>& duration)
+	{
+		const std::chrono::milliseconds duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+		return pop_front(item, pdMS_TO_TICKS(duration_ms.count()));
+	}
+
+	//hand out our internal node, no copy or move of T
+	unique_node_ptr pop_front_ptr()
+	{
+		return pop_front_ptr(0);
+	}
+
+	unique_node_ptr pop_front_ptr(const TickType_t xTicksToWait)
+	{
+		if(!m_num_items.try_take_for_ticks(xTicksToWait))
+		{
+			return unique_node_ptr();
+		}
+
+		T* ptr = nullptr;
+		{
+			Critical_section lock;
+			ptr = heap_pop();
+		}
+
+		return unique_node_ptr(ptr);
+	}
+
+	template< class Rep, class Period >
+	unique_node_ptr pop_front_ptr(const std::chrono::duration<Rep,Period>& duration)
+	{
+		const std::chrono::milliseconds duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+		return pop_front_ptr(pdMS_TO_TICKS(duration_ms.count()));
+	}
+
+	bool pop_front_isr(T* const item)
+	{
+		BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+		const bool ret = pop_front_isr(item, &xHigherPriorityTaskWoken);
+
+		portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+
+		return ret;
+	}
+
+	bool pop_front_isr(T* const item, BaseType_t* const pxHigherPriorityTaskWoken)
+	{
+		if(!m_num_items.take_from_isr(pxHigherPriorityTaskWoken))
+		{
+			return false;
+		}
+
+		T* ptr = nullptr;
+		{
+			Critical_section_isr lock;
+			ptr = heap_pop();
+		}
+
+		*item = std::move(*ptr);
+
+		m_pool.deallocate_isr(ptr, pxHigherPriorityTaskWoken);
+
+		return true;
+	}
+
+	bool push(const T& item)
+	{
+		return push(item, 0);
+	}
+
+	bool push_wait(const T& item, const bool wait)
+	{
+		bool ret = false;
+
+		if(wait)
+		{
+			do
+			{
+				ret = push(item, portMAX_DELAY);
+			} while(ret != true);
+		}
+		else
+		{
+			ret = push(item, 0);
+		}
+
+		return ret;
+	}
+
+	bool push(const T& item, const TickType_t xTicksToWait)
+	{
+		return try_emplace_for_ticks(xTicksToWait, item);
+	}
+
+	template< class Rep, class Period >
+	bool push(const T& item, const std::chrono::duration<Rep,Period>& duration)
+	{
+		const std::chrono::milliseconds duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+		return push(item, pdMS_TO_TICKS(duration_ms.count()));
+	}
+
+	bool push(T&& item)
+	{
+		return push(std::move(item), 0);
+	}
+
+	bool push(T&& item, const TickType_t xTicksToWait)
+	{
+		return try_emplace_for_ticks(xTicksToWait, std::move(item));
+	}
+
+	//construct in place in our pool
+	template<typename... Args>
+	bool emplace(Args&&... args)
+	{
+		return try_emplace_for_ticks(0, std::forward<Args>(args)...);
+	}
+
+	template<typename... Args>
+	bool try_emplace_for_ticks(const TickType_t xTicksToWait, Args&&... args)
+	{
+		T* const ptr = m_pool.try_allocate_for_ticks(xTicksToWait, std::forward<Args>(args)...);
+		if(!ptr)
+		{
+			return false;
+		}
+
+		{
+			Critical_section lock;
+			heap_push(ptr);
+		}
+
+		m_num_items.give();
+
+		return true;
+	}
+
+	bool push_isr(const T& item)
+	{
+		BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+		const bool ret = push_isr(item, &xHigherPriorityTaskWoken);
+
+		portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+
+		return ret;
+	}
+
+	bool push_isr(const T& item, BaseType_t* const pxHigherPriorityTaskWoken)
+	{
+		return try_emplace_isr(pxHigherPriorityTaskWoken, item);
+	}
+
+	template<typename... Args>
+	bool try_emplace_isr(BaseType_t* const pxHigherPriorityTaskWoken, Args&&... args)
+	{
+		T* const ptr = m_pool.try_allocate_isr(pxHigherPriorityTaskWoken, std::forward<Args>(args)...);
+		if(!ptr)
+		{
+			return false;
+		}
+
+		{
+			Critical_section_isr lock;
+			heap_push(ptr);
+		}
+
+		m_num_items.give_from_isr(pxHigherPriorityTaskWoken);
+
+		return true;
+	}
+
+protected:
+
+	//caller must hold a critical section
+	void heap_push(T* const ptr)
+	{
+		size_t idx = m_heap_size;
+		m_heap_size++;
+
+		//sift up
+		while(idx > 0)
+		{
+			const size_t parent = (idx - 1) / 2;
+			if(!m_comp(*m_heap[parent], *ptr))
+			{
+				break;
+			}
+
+			m_heap[idx] = m_heap[parent];
+			idx = parent;
+		}
+
+		m_heap[idx] = ptr;
+	}
+
+	//caller must hold a critical section and a m_num_items count
+	T* heap_pop()
+	{
+		T* const top = m_heap[0];
+
+		m_heap_size--;
+		if(m_heap_size == 0)
+		{
+			return top;
+		}
+
+		//sift the last element down from the root
+		T* const last = m_heap[m_heap_size];
+		size_t idx = 0;
+		for(;;)
+		{
+			size_t child = 2 * idx + 1;
+			if(child >= m_heap_size)
+			{
+				break;
+			}
+
+			if(((child + 1) < m_heap_size) && m_comp(*m_heap[child], *m_heap[child + 1]))
+			{
+				child++;
+			}
+
+			if(!m_comp(*last, *m_heap[child]))
+			{
+				break;
+			}
+
+			m_heap[idx] = m_heap[child];
+			idx = child;
+		}
+
+		m_heap[idx] = last;
+
+		return top;
+	}
+
+	Object_pool<T, LEN> m_pool;
+
+	//number of items in the heap that can be popped
+	CSema_static m_num_items;
+
+	std::array<T*, LEN> m_heap;
+	size_t m_heap_size;
+
+	Compare m_comp;
+};
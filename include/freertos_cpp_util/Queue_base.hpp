@@ -9,18 +9,31 @@
 
 #include "common_util/Non_copyable.hpp"
 
+#include "freertos_cpp_util/Critical_section_isr.hpp"
+#include "freertos_cpp_util/Queue_stats.hpp"
+#include "freertos_cpp_util/Suspend_task_scheduler.hpp"
+
 #include "FreeRTOS.h"
 #include "queue.h"
 
+#include <algorithm>
 #include <chrono>
+#include <functional>
 #include <type_traits>
 
-class Queue_base : private Non_copyable
+template <typename Derived, typename T>
+class Queue_pod_ops;
+
+///
+/// Owns a kernel queue handle, without a vtable
+/// Base for the statically dispatched queues
+///
+class Queue_handle : private Non_copyable
 {
-public:
+	template <typename Derived, typename T>
+	friend class Queue_pod_ops;
 
-	Queue_base();
-	virtual ~Queue_base();
+public:
 
 	void clear()
 	{
@@ -68,12 +81,131 @@ public:
 
 	void set_name(const char* name)
 	{
-		vQueueAddToRegistry(m_queue, name);
+		if(m_queue)
+		{
+			vQueueAddToRegistry(m_queue, name);
+		}
+
+#if FREERTOS_CPP_UTIL_QUEUE_STATS
+		register_stats(name);
+#endif
 	}
 
+	QueueHandle_t get_handle() const
+	{
+		return m_queue;
+	}
+
+#if FREERTOS_CPP_UTIL_QUEUE_STATS
+	const Queue_stats& get_stats() const
+	{
+		return m_stats;
+	}
+
+	void reset_stats()
+	{
+		m_stats.reset();
+	}
+
+	//snapshot of the queue named name with set_name
+	static bool get_stats_by_name(const char* name, Queue_stats_snapshot* const out);
+
+	//visit every named queue, called with the scheduler suspended so func must not block
+	static void for_each_stats(const std::function<void(const Queue_stats_snapshot&)>& func);
+#endif
+
 protected:
 
+	Queue_handle();
+	~Queue_handle();
+
+	//stats hooks, compile to nothing unless FREERTOS_CPP_UTIL_QUEUE_STATS
+	//fill_queue is the kernel queue whose depth is the fill level
+	TickType_t stats_start(const TickType_t xTicksToWait) const
+	{
+#if FREERTOS_CPP_UTIL_QUEUE_STATS
+		return (xTicksToWait != 0) ? xTaskGetTickCount() : 0;
+#else
+		(void)xTicksToWait;
+		return 0;
+#endif
+	}
+
+	void stats_push(const bool success, const QueueHandle_t fill_queue, const TickType_t xTicksToWait, const TickType_t start)
+	{
+#if FREERTOS_CPP_UTIL_QUEUE_STATS
+		const TickType_t blocked_ticks = (xTicksToWait != 0) ? (xTaskGetTickCount() - start) : 0;
+		m_stats.record_push(success, success ? uxQueueMessagesWaiting(fill_queue) : 0, blocked_ticks);
+#else
+		(void)success;
+		(void)fill_queue;
+		(void)xTicksToWait;
+		(void)start;
+#endif
+	}
+
+	void stats_push_isr(const bool success, const QueueHandle_t fill_queue)
+	{
+#if FREERTOS_CPP_UTIL_QUEUE_STATS
+		m_stats.record_push(success, success ? uxQueueMessagesWaitingFromISR(fill_queue) : 0, 0);
+#else
+		(void)success;
+		(void)fill_queue;
+#endif
+	}
+
+	void stats_pop(const bool success, const TickType_t xTicksToWait, const TickType_t start)
+	{
+#if FREERTOS_CPP_UTIL_QUEUE_STATS
+		const TickType_t blocked_ticks = (xTicksToWait != 0) ? (xTaskGetTickCount() - start) : 0;
+		m_stats.record_pop(success, blocked_ticks);
+#else
+		(void)success;
+		(void)xTicksToWait;
+		(void)start;
+#endif
+	}
+
+	void stats_pop_isr(const bool success)
+	{
+#if FREERTOS_CPP_UTIL_QUEUE_STATS
+		m_stats.record_pop(success, 0);
+#else
+		(void)success;
+#endif
+	}
+
 	QueueHandle_t m_queue;
+
+#if FREERTOS_CPP_UTIL_QUEUE_STATS
+	void register_stats(const char* name);
+	void unregister_stats();
+
+	Queue_stats m_stats;
+
+	//list of named queues, for lookup by name
+	const char* m_stats_name;
+	Queue_handle* m_stats_next;
+
+	static Queue_handle* m_stats_head;
+#endif
+};
+
+///
+/// Virtual base of the dynamically dispatched queues
+///
+class Queue_base : public Queue_handle
+{
+public:
+
+	Queue_base();
+	virtual ~Queue_base();
+
+	//queues that own the items behind m_queue override this to destroy them
+	virtual void clear()
+	{
+		Queue_handle::clear();
+	}
 };
 
 template <typename T>
@@ -124,19 +256,53 @@ public:
 	virtual bool push_back_isr(const T& item, BaseType_t* const pxHigherPriorityTaskWoken) = 0;
 };
 
+///
+/// Base of the queues for full C++ objects
+/// A copyable T gets the full Queue_template_base interface
+/// A move only T can not implement the const T& pushes, so it gets a plain Queue_base
+/// and the const T& pushes of the derived queue are only instantiated, and rejected, if used
+///
 template <typename T>
-class Queue_template_base_pod : public Queue_template_base<T>
+using Queue_object_base = typename std::conditional<std::is_copy_constructible<T>::value, Queue_template_base<T>, Queue_base>::type;
+
+///
+/// Statically dispatched queue operations for POD types
+/// Derived must provide get_handle(), calls compile to a direct kernel call
+///
+template <typename Derived, typename T>
+class Queue_pod_ops
 {
 public:
 
 	static_assert(std::is_pod<T>::value, "T must be POD");
 
-	bool pop_front(T* const item) override
+	template< class Rep, class Period >
+	bool pop_front(T* const item, const std::chrono::duration<Rep,Period>& duration)
+	{
+		const std::chrono::milliseconds duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+		return pop_front(item, pdMS_TO_TICKS(duration_ms.count()));
+	}
+
+	template< class Rep, class Period >
+	bool push_back(const T& item, const std::chrono::duration<Rep,Period>& duration)
+	{
+		const std::chrono::milliseconds duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+		return push_back(item, pdMS_TO_TICKS(duration_ms.count()));
+	}
+
+	template< class Rep, class Period >
+	bool push_front(const T& item, const std::chrono::duration<Rep,Period>& duration)
+	{
+		const std::chrono::milliseconds duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+		return push_front(item, pdMS_TO_TICKS(duration_ms.count()));
+	}
+
+	bool pop_front(T* const item)
 	{
 		return pop_front(item, 0);
 	}
 
-	bool pop_front_wait(T* const item, const bool wait) override
+	bool pop_front_wait(T* const item, const bool wait)
 	{
 		bool ret = false;
 
@@ -155,12 +321,18 @@ public:
 		return ret;
 	}
 
-	bool pop_front(T* const item, const TickType_t xTicksToWait) override
+	bool pop_front(T* const item, const TickType_t xTicksToWait)
 	{
-		return xQueueReceive(this->m_queue, item, xTicksToWait) == pdTRUE;
+		const TickType_t start = base()->stats_start(xTicksToWait);
+
+		const bool ret = xQueueReceive(handle(), item, xTicksToWait) == pdTRUE;
+
+		base()->stats_pop(ret, xTicksToWait, start);
+
+		return ret;
 	}
 
-	bool pop_front_isr(T* const item) override
+	bool pop_front_isr(T* const item)
 	{
 		BaseType_t xHigherPriorityTaskWoken = pdFALSE;
 		
@@ -171,17 +343,21 @@ public:
 		return ret;
 	}
 
-	bool pop_front_isr(T* const item, BaseType_t* const pxHigherPriorityTaskWoken) override
+	bool pop_front_isr(T* const item, BaseType_t* const pxHigherPriorityTaskWoken)
 	{
-		return pdTRUE == xQueueReceiveFromISR(this->m_queue, item, pxHigherPriorityTaskWoken);
+		const bool ret = pdTRUE == xQueueReceiveFromISR(handle(), item, pxHigherPriorityTaskWoken);
+
+		base()->stats_pop_isr(ret);
+
+		return ret;
 	}
 
-	bool push_back(const T& item) override
+	bool push_back(const T& item)
 	{
 		return push_back(item, 0);
 	}
 
-	bool push_back_wait(const T& item, const bool wait) override
+	bool push_back_wait(const T& item, const bool wait)
 	{
 		bool ret = false;
 
@@ -200,17 +376,23 @@ public:
 		return ret;
 	}
 
-	bool push_back(const T& item, const TickType_t xTicksToWait) override
+	bool push_back(const T& item, const TickType_t xTicksToWait)
 	{
-		return xQueueSendToBack(this->m_queue, &item, xTicksToWait) == pdTRUE;
+		const TickType_t start = base()->stats_start(xTicksToWait);
+
+		const bool ret = xQueueSendToBack(handle(), &item, xTicksToWait) == pdTRUE;
+
+		base()->stats_push(ret, handle(), xTicksToWait, start);
+
+		return ret;
 	}
 
-	bool push_front(const T& item) override
+	bool push_front(const T& item)
 	{
 		return push_front(item, 0);
 	}
 
-	bool push_front_wait(const T& item, const bool wait) override
+	bool push_front_wait(const T& item, const bool wait)
 	{
 		bool ret = false;
 
@@ -229,12 +411,18 @@ public:
 		return ret;
 	}
 
-	bool push_front(const T& item, const TickType_t xTicksToWait) override
+	bool push_front(const T& item, const TickType_t xTicksToWait)
 	{
-		return xQueueSendToFront(this->m_queue, &item, xTicksToWait) == pdTRUE;
+		const TickType_t start = base()->stats_start(xTicksToWait);
+
+		const bool ret = xQueueSendToFront(handle(), &item, xTicksToWait) == pdTRUE;
+
+		base()->stats_push(ret, handle(), xTicksToWait, start);
+
+		return ret;
 	}
 
-	bool push_front_isr(const T& item) override
+	bool push_front_isr(const T& item)
 	{
 		BaseType_t xHigherPriorityTaskWoken = pdFALSE;
 		
@@ -245,12 +433,16 @@ public:
 		return ret;
 	}
 
-	bool push_front_isr(const T& item, BaseType_t* const pxHigherPriorityTaskWoken) override
+	bool push_front_isr(const T& item, BaseType_t* const pxHigherPriorityTaskWoken)
 	{
-		return pdTRUE == xQueueSendToFrontFromISR(this->m_queue, &item, pxHigherPriorityTaskWoken);
+		const bool ret = pdTRUE == xQueueSendToFrontFromISR(handle(), &item, pxHigherPriorityTaskWoken);
+
+		base()->stats_push_isr(ret, handle());
+
+		return ret;
 	}
 
-	bool push_back_isr(const T& item) override
+	bool push_back_isr(const T& item)
 	{
 		BaseType_t xHigherPriorityTaskWoken = pdFALSE;
 		
@@ -261,8 +453,353 @@ public:
 		return ret;
 	}
 
+	bool push_back_isr(const T& item, BaseType_t* const pxHigherPriorityTaskWoken)
+	{
+		const bool ret = pdTRUE == xQueueSendToBackFromISR(handle(), &item, pxHigherPriorityTaskWoken);
+
+		base()->stats_push_isr(ret, handle());
+
+		return ret;
+	}
+
+	//most items moved per isr critical section by the batch isr api, bounds the time interrupts are masked
+	static constexpr size_t ISR_BATCH_LEN = 8;
+
+	//the batch api saves the per item wake up and context switch, not the kernel call
+	//a FreeRTOS queue has no multi item send or receive, so each item is still one xQueueSend / xQueueReceive
+	//for a single copy of a whole run use Stream_buffer or Message_buffer
+
+	//batch push, returns the number of items pushed
+	//items are sent with the scheduler suspended so a woken reader is only switched to once per run
+	//blocks for space only when the queue fills, up to xTicksToWait total
+	size_t push_back_n(const T* const items, const size_t num, const TickType_t xTicksToWait)
+	{
+		return push_n(items, num, xTicksToWait, false);
+	}
+
+	template< class Rep, class Period >
+	size_t push_back_n(const T* const items, const size_t num, const std::chrono::duration<Rep,Period>& duration)
+	{
+		const std::chrono::milliseconds duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+		return push_back_n(items, num, pdMS_TO_TICKS(duration_ms.count()));
+	}
+
+	size_t push_back_n_isr(const T* const items, const size_t num)
+	{
+		BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+		const size_t ret = push_back_n_isr(items, num, &xHigherPriorityTaskWoken);
+
+		portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+
+		return ret;
+	}
+
+	//batch push from isr, returns the number of items pushed
+	//each run of up to ISR_BATCH_LEN items is pushed atomically with respect to other isr
+	size_t push_back_n_isr(const T* const items, const size_t num, BaseType_t* const pxHigherPriorityTaskWoken)
+	{
+		return push_n_isr(items, num, pxHigherPriorityTaskWoken, false);
+	}
+
+	//batch push to the front, returns the number of items pushed
+	//the last item pushed is the first popped
+	size_t push_front_n(const T* const items, const size_t num, const TickType_t xTicksToWait)
+	{
+		return push_n(items, num, xTicksToWait, true);
+	}
+
+	template< class Rep, class Period >
+	size_t push_front_n(const T* const items, const size_t num, const std::chrono::duration<Rep,Period>& duration)
+	{
+		const std::chrono::milliseconds duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+		return push_front_n(items, num, pdMS_TO_TICKS(duration_ms.count()));
+	}
+
+	size_t push_front_n_isr(const T* const items, const size_t num)
+	{
+		BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+		const size_t ret = push_front_n_isr(items, num, &xHigherPriorityTaskWoken);
+
+		portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+
+		return ret;
+	}
+
+	size_t push_front_n_isr(const T* const items, const size_t num, BaseType_t* const pxHigherPriorityTaskWoken)
+	{
+		return push_n_isr(items, num, pxHigherPriorityTaskWoken, true);
+	}
+
+	//batch pop, returns the number of items popped
+	//blocks up to xTicksToWait for the first item, then drains up to max_num without blocking
+	size_t pop_front_n(T* const items, const size_t max_num, const TickType_t xTicksToWait)
+	{
+		if(max_num == 0)
+		{
+			return 0;
+		}
+
+		const TickType_t start = base()->stats_start(xTicksToWait);
+
+		const bool ret = xQueueReceive(handle(), &items[0], xTicksToWait) == pdTRUE;
+
+		base()->stats_pop(ret, xTicksToWait, start);
+
+		if(!ret)
+		{
+			return 0;
+		}
+
+		size_t num_popped = 1;
+		{
+			Suspend_task_scheduler lock;
+
+			while(num_popped < max_num)
+			{
+				if(xQueueReceive(handle(), &items[num_popped], 0) != pdTRUE)
+				{
+					break;
+				}
+				num_popped++;
+			}
+		}
+
+		return num_popped;
+	}
+
+	template< class Rep, class Period >
+	size_t pop_front_n(T* const items, const size_t max_num, const std::chrono::duration<Rep,Period>& duration)
+	{
+		const std::chrono::milliseconds duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+		return pop_front_n(items, max_num, pdMS_TO_TICKS(duration_ms.count()));
+	}
+
+	size_t pop_front_n_isr(T* const items, const size_t max_num)
+	{
+		BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+		const size_t ret = pop_front_n_isr(items, max_num, &xHigherPriorityTaskWoken);
+
+		portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+
+		return ret;
+	}
+
+	//batch pop from isr, returns the number of items popped
+	//each run of up to ISR_BATCH_LEN items is popped atomically with respect to other isr
+	size_t pop_front_n_isr(T* const items, const size_t max_num, BaseType_t* const pxHigherPriorityTaskWoken)
+	{
+		size_t num_popped = 0;
+		bool empty = false;
+		while(!empty && (num_popped < max_num))
+		{
+			Critical_section_isr lock;
+
+			const size_t run_end = std::min(max_num, num_popped + ISR_BATCH_LEN);
+			while(num_popped < run_end)
+			{
+				if(pdTRUE != xQueueReceiveFromISR(handle(), &items[num_popped], pxHigherPriorityTaskWoken))
+				{
+					empty = true;
+					break;
+				}
+				num_popped++;
+			}
+		}
+
+		base()->stats_pop_isr(num_popped != 0);
+
+		return num_popped;
+	}
+
+protected:
+
+	//batch push to the back or front of the queue, returns the number of items pushed
+	//items are sent with the scheduler suspended so a woken reader is only switched to once per run
+	//blocks for space only when the queue fills, up to xTicksToWait total
+	size_t push_n(const T* const items, const size_t num, const TickType_t xTicksToWait, const bool front)
+	{
+		const TickType_t start = base()->stats_start(xTicksToWait);
+
+		TickType_t ticks_left = xTicksToWait;
+		TimeOut_t xTimeOut;
+		vTaskSetTimeOutState(&xTimeOut);
+
+		size_t num_pushed = 0;
+		for(;;)
+		{
+			{
+				Suspend_task_scheduler lock;
+
+				while(num_pushed < num)
+				{
+					if(send(&items[num_pushed], 0, front) != pdTRUE)
+					{
+						break;
+					}
+					num_pushed++;
+				}
+			}
+
+			if(num_pushed == num)
+			{
+				break;
+			}
+
+			if(pdFALSE != xTaskCheckForTimeOut(&xTimeOut, &ticks_left))
+			{
+				break;
+			}
+
+			//full, wait for space for the next one
+			if(send(&items[num_pushed], ticks_left, front) != pdTRUE)
+			{
+				break;
+			}
+			num_pushed++;
+		}
+
+		base()->stats_push(num_pushed == num, handle(), xTicksToWait, start);
+
+		return num_pushed;
+	}
+
+	//batch push from isr to the back or front of the queue, returns the number of items pushed
+	//each run of up to ISR_BATCH_LEN items is pushed atomically with respect to other isr
+	size_t push_n_isr(const T* const items, const size_t num, BaseType_t* const pxHigherPriorityTaskWoken, const bool front)
+	{
+		size_t num_pushed = 0;
+		bool full = false;
+		while(!full && (num_pushed < num))
+		{
+			Critical_section_isr lock;
+
+			const size_t run_end = std::min(num, num_pushed + ISR_BATCH_LEN);
+			while(num_pushed < run_end)
+			{
+				if(pdTRUE != send_isr(&items[num_pushed], pxHigherPriorityTaskWoken, front))
+				{
+					full = true;
+					break;
+				}
+				num_pushed++;
+			}
+		}
+
+		base()->stats_push_isr(num_pushed == num, handle());
+
+		return num_pushed;
+	}
+
+	BaseType_t send(const T* const item, const TickType_t xTicksToWait, const bool front)
+	{
+		return front ? xQueueSendToFront(handle(), item, xTicksToWait) : xQueueSendToBack(handle(), item, xTicksToWait);
+	}
+
+	BaseType_t send_isr(const T* const item, BaseType_t* const pxHigherPriorityTaskWoken, const bool front)
+	{
+		return front ? xQueueSendToFrontFromISR(handle(), item, pxHigherPriorityTaskWoken) : xQueueSendToBackFromISR(handle(), item, pxHigherPriorityTaskWoken);
+	}
+
+	QueueHandle_t handle() const
+	{
+		return static_cast<const Derived*>(this)->get_handle();
+	}
+
+	Queue_handle* base()
+	{
+		return static_cast<Derived*>(this);
+	}
+};
+
+///
+/// Opt-in virtual adapter, for when a POD queue must be used through Queue_template_base
+///
+template <typename T>
+class Queue_template_base_pod : public Queue_template_base<T>, public Queue_pod_ops<Queue_template_base_pod<T>, T>
+{
+public:
+
+	typedef Queue_pod_ops<Queue_template_base_pod<T>, T> Ops;
+
+	using Queue_template_base<T>::pop_front;
+	using Queue_template_base<T>::push_back;
+	using Queue_template_base<T>::push_front;
+
+	bool pop_front(T* const item) override
+	{
+		return Ops::pop_front(item);
+	}
+
+	bool pop_front_wait(T* const item, const bool wait) override
+	{
+		return Ops::pop_front_wait(item, wait);
+	}
+
+	bool pop_front(T* const item, const TickType_t xTicksToWait) override
+	{
+		return Ops::pop_front(item, xTicksToWait);
+	}
+
+	bool pop_front_isr(T* const item) override
+	{
+		return Ops::pop_front_isr(item);
+	}
+
+	bool pop_front_isr(T* const item, BaseType_t* const pxHigherPriorityTaskWoken) override
+	{
+		return Ops::pop_front_isr(item, pxHigherPriorityTaskWoken);
+	}
+
+	bool push_back(const T& item) override
+	{
+		return Ops::push_back(item);
+	}
+
+	bool push_back_wait(const T& item, const bool wait) override
+	{
+		return Ops::push_back_wait(item, wait);
+	}
+
+	bool push_back(const T& item, const TickType_t xTicksToWait) override
+	{
+		return Ops::push_back(item, xTicksToWait);
+	}
+
+	bool push_front(const T& item) override
+	{
+		return Ops::push_front(item);
+	}
+
+	bool push_front_wait(const T& item, const bool wait) override
+	{
+		return Ops::push_front_wait(item, wait);
+	}
+
+	bool push_front(const T& item, const TickType_t xTicksToWait) override
+	{
+		return Ops::push_front(item, xTicksToWait);
+	}
+
+	bool push_front_isr(const T& item) override
+	{
+		return Ops::push_front_isr(item);
+	}
+
+	bool push_front_isr(const T& item, BaseType_t* const pxHigherPriorityTaskWoken) override
+	{
+		return Ops::push_front_isr(item, pxHigherPriorityTaskWoken);
+	}
+
+	bool push_back_isr(const T& item) override
+	{
+		return Ops::push_back_isr(item);
+	}
+
 	bool push_back_isr(const T& item, BaseType_t* const pxHigherPriorityTaskWoken) override
 	{
-		return pdTRUE == xQueueSendToBackFromISR(this->m_queue, &item, pxHigherPriorityTaskWoken);
+		return Ops::push_back_isr(item, pxHigherPriorityTaskWoken);
 	}
 };
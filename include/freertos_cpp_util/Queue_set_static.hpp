@@ -0,0 +1,135 @@
+/**
+ * @brief Stack allocated queue set
+ * @author Jacob Schloss <jacob@schloss.io>
+ * @copyright Copyright (c) 2026 Jacob Schloss. All rights reserved.
+ * @license Licensed under the 3-Clause BSD license. See LICENSE for details
+*/
+
+#pragma once
+
+#include "freertos_cpp_util/Queue_base.hpp"
+#include "freertos_cpp_util/Semaphore_base.hpp"
+
+#include "common_util/Non_copyable.hpp"
+
+#include "FreeRTOS.h"
+#include "queue.h"
+
+#include <array>
+#include <chrono>
+
+///
+/// Block on several queues and semaphores at once
+/// Needs configUSE_QUEUE_SETS
+///
+/// EVENTS must be at least the sum of the lengths of all member queues and the max counts of all member semaphores
+/// Members must be empty when added, and must only be read after being returned by select
+///
+template<size_t EVENTS>
+class Queue_set_static : private Non_copyable
+{
+public:
+
+	Queue_set_static()
+	{
+		m_set_buf = {0};
+
+		//same as xQueueCreateSetStatic, which is not in every kernel version
+		m_set = xQueueGenericCreateStatic(EVENTS, sizeof(QueueSetMemberHandle_t), reinterpret_cast<uint8_t*>(m_buf.data()), &m_set_buf, queueQUEUE_TYPE_SET);
+	}
+
+	~Queue_set_static()
+	{
+		if(m_set)
+		{
+			vQueueDelete(m_set);
+			m_set = nullptr;
+		}
+	}
+
+	//queue must own a kernel queue, false if it has none
+	bool add(const Queue_handle& queue)
+	{
+		return add_member(queue.get_handle());
+	}
+
+	bool add(const Semaphore_base& sema)
+	{
+		return add_member(sema.get_handle());
+	}
+
+	bool remove(const Queue_handle& queue)
+	{
+		return pdPASS == xQueueRemoveFromSet(queue.get_handle(), m_set);
+	}
+
+	bool remove(const Semaphore_base& sema)
+	{
+		return pdPASS == xQueueRemoveFromSet(sema.get_handle(), m_set);
+	}
+
+	//returns the handle of the member that is ready, or nullptr on timeout
+	//compare against the member's get_handle()
+	QueueSetMemberHandle_t select()
+	{
+		QueueSetMemberHandle_t ret = nullptr;
+		do
+		{
+			ret = select(portMAX_DELAY);
+		} while(ret == nullptr);
+
+		return ret;
+	}
+
+	QueueSetMemberHandle_t select(const TickType_t xTicksToWait)
+	{
+		return xQueueSelectFromSet(m_set, xTicksToWait);
+	}
+
+	template< class Rep, class Period >
+	QueueSetMemberHandle_t select(const std::chrono::duration<Rep,Period>& duration)
+	{
+		const std::chrono::milliseconds duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+		return select(pdMS_TO_TICKS(duration_ms.count()));
+	}
+
+	QueueSetMemberHandle_t select_isr()
+	{
+		return xQueueSelectFromSetFromISR(m_set);
+	}
+
+	static bool is(const QueueSetMemberHandle_t member, const Queue_handle& queue)
+	{
+		return member == queue.get_handle();
+	}
+
+	static bool is(const QueueSetMemberHandle_t member, const Semaphore_base& sema)
+	{
+		return member == sema.get_handle();
+	}
+
+	QueueSetHandle_t get_handle() const
+	{
+		return m_set;
+	}
+
+protected:
+
+	bool add_member(const QueueSetMemberHandle_t member)
+	{
+		configASSERT(member != nullptr);
+
+		if(member == nullptr)
+		{
+			return false;
+		}
+
+		return pdPASS == xQueueAddToSet(member, m_set);
+	}
+
+	QueueSetHandle_t m_set;
+
+	StaticQueue_t m_set_buf;
+
+	std::array<QueueSetMemberHandle_t, EVENTS> m_buf;
+};
@@ -10,131 +10,487 @@
 #include "freertos_cpp_util/Queue_static_pod.hpp"
 #include "freertos_cpp_util/object_pool/Object_pool.hpp"
 
+#include <type_traits>
+#include <utility>
+
 template<typename T, size_t LEN>
-class Queue_static : public Queue_template_base<T>
+class Queue_static : public Queue_object_base<T>
 {
 public:
 
+	typedef typename Object_pool<T, LEN>::unique_node_ptr unique_node_ptr;
+
+	//our queue handle is the pointer queue, so size, full, set_name and queue sets work on it
 	Queue_static()
 	{
-		
+		this->m_queue = m_alloc_queue.get_handle();
 	}
 	~Queue_static() override
 	{
-		T* ptr = nullptr;
-		while(m_alloc_queue.pop_front(&ptr))
+		clear();
+
+		//m_alloc_queue owns the kernel queue
+		this->m_queue = nullptr;
+	}
+
+	//destroy all queued items
+	void clear() override
+	{
+		while(unique_node_ptr ptr = pop_front_ptr(0))
 		{
-			m_pool.free(ptr);
+
 		}
 	}
 
-	bool pop_front(T* const item) override
+	bool pop_front(T* const item)
 	{
 		return pop_front(item, 0);
 	}
 
-	bool pop_front(T* const item, const TickType_t xTicksToWait) override
+	bool pop_front_wait(T* const item, const bool wait)
+	{
+		bool ret = false;
+
+		if(wait)
+		{
+			do
+			{
+				ret = pop_front(item, portMAX_DELAY);
+			} while(ret != true);
+		}
+		else
+		{
+			ret = pop_front(item, 0);
+		}
+
+		return ret;
+	}
+
+	bool pop_front(T* const item, const TickType_t xTicksToWait)
 	{
 		//do we have one?
-		T* ptr = nullptr;
-		if(!m_alloc_queue.pop_front(&ptr, xTicksToWait))
+		unique_node_ptr ptr = pop_front_ptr(xTicksToWait);
+		if(!ptr)
 		{
 			return false;
 		}
 
 		//use move, it might be optimized
+		//our internal copy is freed when ptr goes out of scope
 		*item = std::move(*ptr);
 
-		//free our internal copy
-		m_pool.free(ptr);
-
 		return true;
 	}
 
+	template< class Rep, class Period >
+	bool pop_front(T* const item, const std::chrono::duration<Rep,Period>& duration)
+	{
+		const std::chrono::milliseconds duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+		return pop_front(item, pdMS_TO_TICKS(duration_ms.count()));
+	}
+
+	//hand out our internal node, no copy or move of T
+	//the node is returned to our pool when the pointer is destroyed
+	unique_node_ptr pop_front_ptr()
+	{
+		return pop_front_ptr(0);
+	}
+
+	unique_node_ptr pop_front_ptr(const TickType_t xTicksToWait)
+	{
+		const TickType_t start = this->stats_start(xTicksToWait);
+
+		T* ptr = nullptr;
+		const bool ret = m_alloc_queue.pop_front(&ptr, xTicksToWait);
+
+		this->stats_pop(ret, xTicksToWait, start);
+
+		if(!ret)
+		{
+			return unique_node_ptr();
+		}
+
+		return unique_node_ptr(ptr);
+	}
+
+	template< class Rep, class Period >
+	unique_node_ptr pop_front_ptr(const std::chrono::duration<Rep,Period>& duration)
+	{
+		const std::chrono::milliseconds duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+		return pop_front_ptr(pdMS_TO_TICKS(duration_ms.count()));
+	}
+
 	bool pop_front_isr(T* const item)
 	{
-		return false;
+		BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+		const bool ret = pop_front_isr(item, &xHigherPriorityTaskWoken);
+
+		portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+
+		return ret;
 	}
-	
+
 	bool pop_front_isr(T* const item, BaseType_t* const pxHigherPriorityTaskWoken)
 	{
-		return false;
+		T* ptr = nullptr;
+		const bool ret = m_alloc_queue.pop_front_isr(&ptr, pxHigherPriorityTaskWoken);
+
+		this->stats_pop_isr(ret);
+
+		if(!ret)
+		{
+			return false;
+		}
+
+		*item = std::move(*ptr);
+
+		m_pool.deallocate_isr(ptr, pxHigherPriorityTaskWoken);
+
+		return true;
 	}
 
-	bool push_back(const T& item) override
+	bool push_back(const T& item)
 	{
 		return push_back(item, 0);
 	}
 
-	bool push_back(const T& item, const TickType_t xTicksToWait) override
+	bool push_back_wait(const T& item, const bool wait)
 	{
-		//calls copy constructor if there is a free node
-		T* const ptr = m_pool.try_allocate_for_ticks(xTicksToWait, item);
+		bool ret = false;
 
-		if(!ptr)
+		if(wait)
 		{
-			return false;
+			do
+			{
+				ret = push_back(item, portMAX_DELAY);
+			} while(ret != true);
 		}
-
-		//stash our ref
-		if(!m_alloc_queue.push_back(ptr, 0))
+		else
 		{
-			return false;
+			ret = push_back(item, 0);
 		}
 
-		return true;
+		return ret;
 	}
 
-	bool push_front(const T& item) override
+	bool push_back(const T& item, const TickType_t xTicksToWait)
+	{
+		const TickType_t start = this->stats_start(xTicksToWait);
+
+		//calls copy constructor if there is a free node
+		T* const ptr = copy_allocate(xTicksToWait, item);
+
+		return stash_back(ptr, xTicksToWait, start);
+	}
+
+	template< class Rep, class Period >
+	bool push_back(const T& item, const std::chrono::duration<Rep,Period>& duration)
+	{
+		const std::chrono::milliseconds duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+		return push_back(item, pdMS_TO_TICKS(duration_ms.count()));
+	}
+
+	bool push_back(T&& item)
+	{
+		return push_back(std::move(item), 0);
+	}
+
+	bool push_back(T&& item, const TickType_t xTicksToWait)
+	{
+		const TickType_t start = this->stats_start(xTicksToWait);
+
+		//calls move constructor if there is a free node
+		T* const ptr = m_pool.try_allocate_for_ticks(xTicksToWait, std::move(item));
+
+		return stash_back(ptr, xTicksToWait, start);
+	}
+
+	template< class Rep, class Period >
+	bool push_back(T&& item, const std::chrono::duration<Rep,Period>& duration)
+	{
+		const std::chrono::milliseconds duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+		return push_back(std::move(item), pdMS_TO_TICKS(duration_ms.count()));
+	}
+
+	//construct in place in our pool, no copy or move of T
+	template<typename... Args>
+	bool emplace_back(Args&&... args)
+	{
+		return try_emplace_back_for_ticks(0, std::forward<Args>(args)...);
+	}
+
+	template<typename... Args>
+	bool try_emplace_back_for_ticks(const TickType_t xTicksToWait, Args&&... args)
+	{
+		const TickType_t start = this->stats_start(xTicksToWait);
+
+		T* const ptr = m_pool.try_allocate_for_ticks(xTicksToWait, std::forward<Args>(args)...);
+
+		return stash_back(ptr, xTicksToWait, start);
+	}
+
+	bool push_front(const T& item)
 	{
 		return push_front(item, 0);
 	}
 
-	bool push_front(const T& item, const TickType_t xTicksToWait) override
+	bool push_front_wait(const T& item, const bool wait)
 	{
-		//calls copy constructor if there is a free node
-		T* const ptr = m_pool.try_allocate_for_ticks(xTicksToWait, item);
+		bool ret = false;
 
-		if(!ptr)
+		if(wait)
 		{
-			return false;
+			do
+			{
+				ret = push_front(item, portMAX_DELAY);
+			} while(ret != true);
 		}
-
-		//stash our ref
-		if(!m_alloc_queue.push_front(ptr, 0))
+		else
 		{
-			return false;
+			ret = push_front(item, 0);
 		}
 
-		return true;
+		return ret;
+	}
+
+	bool push_front(const T& item, const TickType_t xTicksToWait)
+	{
+		const TickType_t start = this->stats_start(xTicksToWait);
+
+		//calls copy constructor if there is a free node
+		T* const ptr = copy_allocate(xTicksToWait, item);
+
+		return stash_front(ptr, xTicksToWait, start);
+	}
+
+	template< class Rep, class Period >
+	bool push_front(const T& item, const std::chrono::duration<Rep,Period>& duration)
+	{
+		const std::chrono::milliseconds duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+		return push_front(item, pdMS_TO_TICKS(duration_ms.count()));
+	}
+
+	bool push_front(T&& item)
+	{
+		return push_front(std::move(item), 0);
+	}
+
+	bool push_front(T&& item, const TickType_t xTicksToWait)
+	{
+		const TickType_t start = this->stats_start(xTicksToWait);
+
+		//calls move constructor if there is a free node
+		T* const ptr = m_pool.try_allocate_for_ticks(xTicksToWait, std::move(item));
+
+		return stash_front(ptr, xTicksToWait, start);
+	}
+
+	template< class Rep, class Period >
+	bool push_front(T&& item, const std::chrono::duration<Rep,Period>& duration)
+	{
+		const std::chrono::milliseconds duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+		return push_front(std::move(item), pdMS_TO_TICKS(duration_ms.count()));
+	}
+
+	//construct in place in our pool, no copy or move of T
+	template<typename... Args>
+	bool emplace_front(Args&&... args)
+	{
+		return try_emplace_front_for_ticks(0, std::forward<Args>(args)...);
+	}
+
+	template<typename... Args>
+	bool try_emplace_front_for_ticks(const TickType_t xTicksToWait, Args&&... args)
+	{
+		const TickType_t start = this->stats_start(xTicksToWait);
+
+		T* const ptr = m_pool.try_allocate_for_ticks(xTicksToWait, std::forward<Args>(args)...);
+
+		return stash_front(ptr, xTicksToWait, start);
 	}
 
 	bool push_front_isr(const T& item)
 	{
-		//Object_pool is not isr safe yet
-		return false;
+		BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+		const bool ret = push_front_isr(item, &xHigherPriorityTaskWoken);
+
+		portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+
+		return ret;
 	}
 
 	bool push_front_isr(const T& item, BaseType_t* const pxHigherPriorityTaskWoken)
 	{
-		//Object_pool is not isr safe yet
-		return false;
+		T* const ptr = copy_allocate_isr(pxHigherPriorityTaskWoken, item);
+
+		return stash_front_isr(ptr, pxHigherPriorityTaskWoken);
+	}
+
+	bool push_front_isr(T&& item)
+	{
+		BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+		const bool ret = push_front_isr(std::move(item), &xHigherPriorityTaskWoken);
+
+		portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+
+		return ret;
+	}
+
+	bool push_front_isr(T&& item, BaseType_t* const pxHigherPriorityTaskWoken)
+	{
+		T* const ptr = m_pool.try_allocate_isr(pxHigherPriorityTaskWoken, std::move(item));
+
+		return stash_front_isr(ptr, pxHigherPriorityTaskWoken);
+	}
+
+	template<typename... Args>
+	bool try_emplace_front_isr(BaseType_t* const pxHigherPriorityTaskWoken, Args&&... args)
+	{
+		T* const ptr = m_pool.try_allocate_isr(pxHigherPriorityTaskWoken, std::forward<Args>(args)...);
+
+		return stash_front_isr(ptr, pxHigherPriorityTaskWoken);
 	}
 
 	bool push_back_isr(const T& item)
 	{
-		//Object_pool is not isr safe yet
-		return false;
+		BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+		const bool ret = push_back_isr(item, &xHigherPriorityTaskWoken);
+
+		portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+
+		return ret;
 	}
 
 	bool push_back_isr(const T& item, BaseType_t* const pxHigherPriorityTaskWoken)
 	{
-		//Object_pool is not isr safe yet
-		return false;
+		T* const ptr = copy_allocate_isr(pxHigherPriorityTaskWoken, item);
+
+		return stash_back_isr(ptr, pxHigherPriorityTaskWoken);
+	}
+
+	bool push_back_isr(T&& item)
+	{
+		BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+		const bool ret = push_back_isr(std::move(item), &xHigherPriorityTaskWoken);
+
+		portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+
+		return ret;
+	}
+
+	bool push_back_isr(T&& item, BaseType_t* const pxHigherPriorityTaskWoken)
+	{
+		T* const ptr = m_pool.try_allocate_isr(pxHigherPriorityTaskWoken, std::move(item));
+
+		return stash_back_isr(ptr, pxHigherPriorityTaskWoken);
+	}
+
+	template<typename... Args>
+	bool try_emplace_back_isr(BaseType_t* const pxHigherPriorityTaskWoken, Args&&... args)
+	{
+		T* const ptr = m_pool.try_allocate_isr(pxHigherPriorityTaskWoken, std::forward<Args>(args)...);
+
+		return stash_back_isr(ptr, pxHigherPriorityTaskWoken);
 	}
 
 protected:
 
+	//only instantiated for a move only T if a const T& push is used
+	T* copy_allocate(const TickType_t xTicksToWait, const T& item)
+	{
+		static_assert(std::is_copy_constructible<T>::value, "move only types must be pushed by rvalue or emplace");
+
+		return m_pool.try_allocate_for_ticks(xTicksToWait, item);
+	}
+
+	T* copy_allocate_isr(BaseType_t* const pxHigherPriorityTaskWoken, const T& item)
+	{
+		static_assert(std::is_copy_constructible<T>::value, "move only types must be pushed by rvalue or emplace");
+
+		return m_pool.try_allocate_isr(pxHigherPriorityTaskWoken, item);
+	}
+
+	bool stash_back(T* const ptr, const TickType_t xTicksToWait, const TickType_t start)
+	{
+		bool ret = false;
+
+		if(ptr)
+		{
+			//stash our ref
+			//there is one slot per pool node, so this should never fail
+			ret = m_alloc_queue.push_back(ptr, 0);
+			if(!ret)
+			{
+				m_pool.deallocate(ptr);
+			}
+		}
+
+		this->stats_push(ret, m_alloc_queue.get_handle(), xTicksToWait, start);
+
+		return ret;
+	}
+
+	bool stash_front(T* const ptr, const TickType_t xTicksToWait, const TickType_t start)
+	{
+		bool ret = false;
+
+		if(ptr)
+		{
+			//stash our ref
+			//there is one slot per pool node, so this should never fail
+			ret = m_alloc_queue.push_front(ptr, 0);
+			if(!ret)
+			{
+				m_pool.deallocate(ptr);
+			}
+		}
+
+		this->stats_push(ret, m_alloc_queue.get_handle(), xTicksToWait, start);
+
+		return ret;
+	}
+
+	bool stash_back_isr(T* const ptr, BaseType_t* const pxHigherPriorityTaskWoken)
+	{
+		bool ret = false;
+
+		if(ptr)
+		{
+			ret = m_alloc_queue.push_back_isr(ptr, pxHigherPriorityTaskWoken);
+			if(!ret)
+			{
+				m_pool.deallocate_isr(ptr, pxHigherPriorityTaskWoken);
+			}
+		}
+
+		this->stats_push_isr(ret, m_alloc_queue.get_handle());
+
+		return ret;
+	}
+
+	bool stash_front_isr(T* const ptr, BaseType_t* const pxHigherPriorityTaskWoken)
+	{
+		bool ret = false;
+
+		if(ptr)
+		{
+			ret = m_alloc_queue.push_front_isr(ptr, pxHigherPriorityTaskWoken);
+			if(!ret)
+			{
+				m_pool.deallocate_isr(ptr, pxHigherPriorityTaskWoken);
+			}
+		}
+
+		this->stats_push_isr(ret, m_alloc_queue.get_handle());
+
+		return ret;
+	}
+
 	Object_pool<T, LEN> m_pool;
 
 	Queue_static_pod<T*, LEN> m_alloc_queue;
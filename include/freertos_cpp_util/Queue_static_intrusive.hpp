@@ -0,0 +1,630 @@
+/**
+ * @brief Stack allocated queue class for full C++ objects, with one kernel object
+ * @author Jacob Schloss <jacob@schloss.io>
+ * @copyright Copyright (c) 2026 Jacob Schloss. All rights reserved.
+ * @license Licensed under the 3-Clause BSD license. See LICENSE for details
+*/
+
+#pragma once
+
+#include "freertos_cpp_util/Queue_base.hpp"
+#include "freertos_cpp_util/CSema_static.hpp"
+#include "freertos_cpp_util/Critical_section.hpp"
+#include "freertos_cpp_util/Critical_section_isr.hpp"
+
+#include "semphr.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+///
+/// Queue_static_intrusive
+///
+/// Alternative to Queue_static, same interface
+/// Nodes are linked into the FIFO and the free list intrusively, each in a short critical section
+/// The only kernel object on the common path is a counting semaphore of queued items, which is also our queue handle
+/// so size, full, set_name and queue sets work on it
+///
+/// Producers blocked on a full queue wait on a second semaphore, only given while someone is waiting
+///
+template<typename T, size_t LEN>
+class Queue_static_intrusive : public Queue_object_base<T>
+{
+public:
+
+	typedef std::aligned_storage_t<sizeof(T), alignof(T)> Aligned_T;
+
+	//val first, so a T* is a Node*
+	struct Node
+	{
+		Aligned_T val;
+		Node* next;
+	};
+
+	class Node_deleter
+	{
+	public:
+		Node_deleter() : m_queue(nullptr)
+		{
+
+		}
+
+		explicit Node_deleter(Queue_static_intrusive* const queue) : m_queue(queue)
+		{
+
+		}
+
+		void operator()(T* ptr) const
+		{
+			m_queue->free_node(ptr);
+		}
+
+	protected:
+		Queue_static_intrusive* m_queue;
+	};
+	typedef std::unique_ptr<T, Node_deleter> unique_node_ptr;
+
+	Queue_static_intrusive() : m_space_sema(LEN, 0), m_push_waiters(0)
+	{
+		m_sema_buf = {0};
+
+		m_head = nullptr;
+		m_tail = nullptr;
+
+		m_free = nullptr;
+		for(size_t i = 0; i < LEN; i++)
+		{
+			m_nodes[i].next = m_free;
+			m_free = &m_nodes[i];
+		}
+
+		this->m_queue = xSemaphoreCreateCountingStatic(LEN, 0, &m_sema_buf);
+	}
+
+	~Queue_static_intrusive() override
+	{
+		clear();
+	}
+
+	//destroy all queued items
+	void clear() override
+	{
+		while(unique_node_ptr ptr = pop_front_ptr(0))
+		{
+
+		}
+	}
+
+	bool pop_front(T* const item)
+	{
+		return pop_front(item, 0);
+	}
+
+	bool pop_front_wait(T* const item, const bool wait)
+	{
+		bool ret = false;
+
+		if(wait)
+		{
+			do
+			{
+				ret = pop_front(item, portMAX_DELAY);
+			} while(ret != true);
+		}
+		else
+		{
+			ret = pop_front(item, 0);
+		}
+
+		return ret;
+	}
+
+	bool pop_front(T* const item, const TickType_t xTicksToWait)
+	{
+		unique_node_ptr ptr = pop_front_ptr(xTicksToWait);
+		if(!ptr)
+		{
+			return false;
+		}
+
+		*item = std::move(*ptr);
+
+		return true;
+	}
+
+	template< class Rep, class Period >
+	bool pop_front(T* const item, const std::chrono::duration<Rep,Period>& duration)
+	{
+		const std::chrono::milliseconds duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+		return pop_front(item, pdMS_TO_TICKS(duration_ms.count()));
+	}
+
+	//hand out our internal node, no copy or move of T
+	//the node is returned to us when the pointer is destroyed
+	unique_node_ptr pop_front_ptr()
+	{
+		return pop_front_ptr(0);
+	}
+
+	unique_node_ptr pop_front_ptr(const TickType_t xTicksToWait)
+	{
+		const TickType_t start = this->stats_start(xTicksToWait);
+
+		const bool ret = pdTRUE == xSemaphoreTake(this->m_queue, xTicksToWait);
+
+		this->stats_pop(ret, xTicksToWait, start);
+
+		if(!ret)
+		{
+			return unique_node_ptr(nullptr, Node_deleter(this));
+		}
+
+		Node* node = nullptr;
+		{
+			Critical_section lock;
+			node = unlink_front();
+		}
+
+		return unique_node_ptr(reinterpret_cast<T*>(&node->val), Node_deleter(this));
+	}
+
+	template< class Rep, class Period >
+	unique_node_ptr pop_front_ptr(const std::chrono::duration<Rep,Period>& duration)
+	{
+		const std::chrono::milliseconds duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+		return pop_front_ptr(pdMS_TO_TICKS(duration_ms.count()));
+	}
+
+	bool pop_front_isr(T* const item)
+	{
+		BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+		const bool ret = pop_front_isr(item, &xHigherPriorityTaskWoken);
+
+		portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+
+		return ret;
+	}
+
+	bool pop_front_isr(T* const item, BaseType_t* const pxHigherPriorityTaskWoken)
+	{
+		const bool ret = pdTRUE == xSemaphoreTakeFromISR(this->m_queue, pxHigherPriorityTaskWoken);
+
+		this->stats_pop_isr(ret);
+
+		if(!ret)
+		{
+			return false;
+		}
+
+		Node* node = nullptr;
+		{
+			Critical_section_isr lock;
+			node = unlink_front();
+		}
+
+		T* const ptr = reinterpret_cast<T*>(&node->val);
+
+		*item = std::move(*ptr);
+
+		free_node_isr(ptr, pxHigherPriorityTaskWoken);
+
+		return true;
+	}
+
+	bool push_back(const T& item)
+	{
+		return push_back(item, 0);
+	}
+
+	bool push_back_wait(const T& item, const bool wait)
+	{
+		bool ret = false;
+
+		if(wait)
+		{
+			do
+			{
+				ret = push_back(item, portMAX_DELAY);
+			} while(ret != true);
+		}
+		else
+		{
+			ret = push_back(item, 0);
+		}
+
+		return ret;
+	}
+
+	bool push_back(const T& item, const TickType_t xTicksToWait)
+	{
+		return copy_emplace(false, xTicksToWait, item);
+	}
+
+	template< class Rep, class Period >
+	bool push_back(const T& item, const std::chrono::duration<Rep,Period>& duration)
+	{
+		const std::chrono::milliseconds duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+		return push_back(item, pdMS_TO_TICKS(duration_ms.count()));
+	}
+
+	bool push_back(T&& item)
+	{
+		return push_back(std::move(item), 0);
+	}
+
+	bool push_back(T&& item, const TickType_t xTicksToWait)
+	{
+		return emplace_node(false, xTicksToWait, std::move(item));
+	}
+
+	template<typename... Args>
+	bool emplace_back(Args&&... args)
+	{
+		return try_emplace_back_for_ticks(0, std::forward<Args>(args)...);
+	}
+
+	template<typename... Args>
+	bool try_emplace_back_for_ticks(const TickType_t xTicksToWait, Args&&... args)
+	{
+		return emplace_node(false, xTicksToWait, std::forward<Args>(args)...);
+	}
+
+	bool push_front(const T& item)
+	{
+		return push_front(item, 0);
+	}
+
+	bool push_front_wait(const T& item, const bool wait)
+	{
+		bool ret = false;
+
+		if(wait)
+		{
+			do
+			{
+				ret = push_front(item, portMAX_DELAY);
+			} while(ret != true);
+		}
+		else
+		{
+			ret = push_front(item, 0);
+		}
+
+		return ret;
+	}
+
+	bool push_front(const T& item, const TickType_t xTicksToWait)
+	{
+		return copy_emplace(true, xTicksToWait, item);
+	}
+
+	template< class Rep, class Period >
+	bool push_front(const T& item, const std::chrono::duration<Rep,Period>& duration)
+	{
+		const std::chrono::milliseconds duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+		return push_front(item, pdMS_TO_TICKS(duration_ms.count()));
+	}
+
+	bool push_front(T&& item)
+	{
+		return push_front(std::move(item), 0);
+	}
+
+	bool push_front(T&& item, const TickType_t xTicksToWait)
+	{
+		return emplace_node(true, xTicksToWait, std::move(item));
+	}
+
+	template<typename... Args>
+	bool emplace_front(Args&&... args)
+	{
+		return try_emplace_front_for_ticks(0, std::forward<Args>(args)...);
+	}
+
+	template<typename... Args>
+	bool try_emplace_front_for_ticks(const TickType_t xTicksToWait, Args&&... args)
+	{
+		return emplace_node(true, xTicksToWait, std::forward<Args>(args)...);
+	}
+
+	bool push_front_isr(const T& item)
+	{
+		BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+		const bool ret = push_front_isr(item, &xHigherPriorityTaskWoken);
+
+		portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+
+		return ret;
+	}
+
+	bool push_front_isr(const T& item, BaseType_t* const pxHigherPriorityTaskWoken)
+	{
+		return copy_emplace_isr(true, pxHigherPriorityTaskWoken, item);
+	}
+
+	bool push_front_isr(T&& item)
+	{
+		BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+		const bool ret = push_front_isr(std::move(item), &xHigherPriorityTaskWoken);
+
+		portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+
+		return ret;
+	}
+
+	bool push_front_isr(T&& item, BaseType_t* const pxHigherPriorityTaskWoken)
+	{
+		return emplace_node_isr(true, pxHigherPriorityTaskWoken, std::move(item));
+	}
+
+	template<typename... Args>
+	bool try_emplace_front_isr(BaseType_t* const pxHigherPriorityTaskWoken, Args&&... args)
+	{
+		return emplace_node_isr(true, pxHigherPriorityTaskWoken, std::forward<Args>(args)...);
+	}
+
+	bool push_back_isr(const T& item)
+	{
+		BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+		const bool ret = push_back_isr(item, &xHigherPriorityTaskWoken);
+
+		portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+
+		return ret;
+	}
+
+	bool push_back_isr(const T& item, BaseType_t* const pxHigherPriorityTaskWoken)
+	{
+		return copy_emplace_isr(false, pxHigherPriorityTaskWoken, item);
+	}
+
+	bool push_back_isr(T&& item)
+	{
+		BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+		const bool ret = push_back_isr(std::move(item), &xHigherPriorityTaskWoken);
+
+		portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+
+		return ret;
+	}
+
+	bool push_back_isr(T&& item, BaseType_t* const pxHigherPriorityTaskWoken)
+	{
+		return emplace_node_isr(false, pxHigherPriorityTaskWoken, std::move(item));
+	}
+
+	template<typename... Args>
+	bool try_emplace_back_isr(BaseType_t* const pxHigherPriorityTaskWoken, Args&&... args)
+	{
+		return emplace_node_isr(false, pxHigherPriorityTaskWoken, std::forward<Args>(args)...);
+	}
+
+protected:
+
+	//only instantiated for a move only T if a const T& push is used
+	bool copy_emplace(const bool front, const TickType_t xTicksToWait, const T& item)
+	{
+		static_assert(std::is_copy_constructible<T>::value, "move only types must be pushed by rvalue or emplace");
+
+		return emplace_node(front, xTicksToWait, item);
+	}
+
+	bool copy_emplace_isr(const bool front, BaseType_t* const pxHigherPriorityTaskWoken, const T& item)
+	{
+		static_assert(std::is_copy_constructible<T>::value, "move only types must be pushed by rvalue or emplace");
+
+		return emplace_node_isr(front, pxHigherPriorityTaskWoken, item);
+	}
+
+	template<typename... Args>
+	bool emplace_node(const bool front, const TickType_t xTicksToWait, Args&&... args)
+	{
+		const TickType_t start = this->stats_start(xTicksToWait);
+
+		Node* const node = alloc_node(xTicksToWait);
+		if(node)
+		{
+			::new(static_cast<void*>(&node->val)) T(std::forward<Args>(args)...);
+
+			{
+				Critical_section lock;
+				link(node, front);
+			}
+
+			xSemaphoreGive(this->m_queue);
+		}
+
+		this->stats_push(node != nullptr, this->m_queue, xTicksToWait, start);
+
+		return node != nullptr;
+	}
+
+	template<typename... Args>
+	bool emplace_node_isr(const bool front, BaseType_t* const pxHigherPriorityTaskWoken, Args&&... args)
+	{
+		Node* node = nullptr;
+		{
+			Critical_section_isr lock;
+			node = unlink_free();
+		}
+
+		if(node)
+		{
+			::new(static_cast<void*>(&node->val)) T(std::forward<Args>(args)...);
+
+			{
+				Critical_section_isr lock;
+				link(node, front);
+			}
+
+			xSemaphoreGiveFromISR(this->m_queue, pxHigherPriorityTaskWoken);
+		}
+
+		this->stats_push_isr(node != nullptr, this->m_queue);
+
+		return node != nullptr;
+	}
+
+	//caller must hold a critical section
+	void link(Node* const node, const bool front)
+	{
+		if(front)
+		{
+			node->next = m_head;
+			m_head = node;
+			if(m_tail == nullptr)
+			{
+				m_tail = node;
+			}
+		}
+		else
+		{
+			node->next = nullptr;
+			if(m_tail)
+			{
+				m_tail->next = node;
+			}
+			else
+			{
+				m_head = node;
+			}
+			m_tail = node;
+		}
+	}
+
+	//caller must hold a critical section and a count of the item semaphore
+	Node* unlink_front()
+	{
+		Node* const node = m_head;
+
+		m_head = node->next;
+		if(m_head == nullptr)
+		{
+			m_tail = nullptr;
+		}
+
+		return node;
+	}
+
+	//caller must hold a critical section
+	Node* unlink_free()
+	{
+		Node* const node = m_free;
+		if(node)
+		{
+			m_free = node->next;
+		}
+
+		return node;
+	}
+
+	Node* alloc_node(const TickType_t xTicksToWait)
+	{
+		Node* node = nullptr;
+		{
+			Critical_section lock;
+			node = unlink_free();
+		}
+
+		if(node || (xTicksToWait == 0))
+		{
+			return node;
+		}
+
+		TickType_t ticks_left = xTicksToWait;
+		TimeOut_t xTimeOut;
+		vTaskSetTimeOutState(&xTimeOut);
+
+		//count ourself as waiting, then retry before sleeping so a racing free is not lost
+		m_push_waiters.fetch_add(1, std::memory_order_seq_cst);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		for(;;)
+		{
+			{
+				Critical_section lock;
+				node = unlink_free();
+			}
+
+			if(node)
+			{
+				break;
+			}
+
+			if(pdFALSE != xTaskCheckForTimeOut(&xTimeOut, &ticks_left))
+			{
+				break;
+			}
+
+			m_space_sema.try_take_for_ticks(ticks_left);
+		}
+		m_push_waiters.fetch_sub(1, std::memory_order_seq_cst);
+
+		return node;
+	}
+
+	void free_node(T* const ptr)
+	{
+		if(ptr == nullptr)
+		{
+			return;
+		}
+
+		ptr->~T();
+
+		Node* const node = reinterpret_cast<Node*>(ptr);
+		{
+			Critical_section lock;
+			node->next = m_free;
+			m_free = node;
+		}
+
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		if(m_push_waiters.load(std::memory_order_seq_cst) != 0)
+		{
+			m_space_sema.give();
+		}
+	}
+
+	void free_node_isr(T* const ptr, BaseType_t* const pxHigherPriorityTaskWoken)
+	{
+		ptr->~T();
+
+		Node* const node = reinterpret_cast<Node*>(ptr);
+		{
+			Critical_section_isr lock;
+			node->next = m_free;
+			m_free = node;
+		}
+
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		if(m_push_waiters.load(std::memory_order_seq_cst) != 0)
+		{
+			m_space_sema.give_from_isr(pxHigherPriorityTaskWoken);
+		}
+	}
+
+	std::array<Node, LEN> m_nodes;
+
+	Node* m_free;
+
+	Node* m_head;
+	Node* m_tail;
+
+	//counts queued items, this is m_queue
+	StaticSemaphore_t m_sema_buf;
+
+	//given on free only while a producer waits for space
+	CSema_static m_space_sema;
+	std::atomic<size_t> m_push_waiters;
+};
@@ -12,8 +12,9 @@
 #include <array>
 #include <type_traits>
 
+//statically dispatched, no vtable
 template<typename T, size_t LEN>
-class Queue_static_pod : public Queue_template_base_pod<T>
+class Queue_static_pod : public Queue_handle, public Queue_pod_ops<Queue_static_pod<T, LEN>, T>
 {
 public:
 
@@ -26,7 +27,33 @@ public:
 		this->m_queue = xQueueCreateStatic(LEN, sizeof(T), reinterpret_cast<uint8_t*>(m_buf.data()), &m_queue_buf);
 	}
 
-	~Queue_static_pod() override
+	~Queue_static_pod()
+	{
+
+	}
+
+protected:
+	StaticQueue_t m_queue_buf;
+
+	std::array<T, LEN> m_buf;
+};
+
+//usable through Queue_template_base<T>
+template<typename T, size_t LEN>
+class Queue_static_pod_virtual : public Queue_template_base_pod<T>
+{
+public:
+
+	static_assert(std::is_pod<T>::value, "T must be POD");
+
+	Queue_static_pod_virtual()
+	{
+		m_queue_buf = {0};
+		
+		this->m_queue = xQueueCreateStatic(LEN, sizeof(T), reinterpret_cast<uint8_t*>(m_buf.data()), &m_queue_buf);
+	}
+
+	~Queue_static_pod_virtual() override
 	{
 
 	}
@@ -0,0 +1,117 @@
+/**
+ * @brief Queue runtime statistics
+ * @author Jacob Schloss <jacob@schloss.io>
+ * @copyright Copyright (c) 2026 Jacob Schloss. All rights reserved.
+ * @license Licensed under the 3-Clause BSD license. See LICENSE for details
+*/
+
+#pragma once
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include <atomic>
+
+#include <cstddef>
+#include <cstdint>
+
+//1 to count queue fill, failures and blocked time
+//off by default, the counters cost an atomic update and a tick read per call
+//this changes the layout of Queue_handle, so set it with the FREERTOS_CPP_UTIL_QUEUE_STATS cmake option
+//which defines it for the library and everything linking it alike
+#ifndef FREERTOS_CPP_UTIL_QUEUE_STATS
+#define FREERTOS_CPP_UTIL_QUEUE_STATS 0
+#endif
+
+struct Queue_stats_snapshot
+{
+	const char* name;
+
+	size_t high_water_mark;
+
+	uint32_t push_fail;
+	uint32_t pop_fail;
+
+	TickType_t push_blocked_ticks;
+	TickType_t pop_blocked_ticks;
+};
+
+class Queue_stats
+{
+public:
+
+	Queue_stats() : m_high_water_mark(0), m_push_fail(0), m_pop_fail(0), m_push_blocked_ticks(0), m_pop_blocked_ticks(0)
+	{
+
+	}
+
+	void reset()
+	{
+		m_high_water_mark.store(0, std::memory_order_relaxed);
+		m_push_fail.store(0, std::memory_order_relaxed);
+		m_pop_fail.store(0, std::memory_order_relaxed);
+		m_push_blocked_ticks.store(0, std::memory_order_relaxed);
+		m_pop_blocked_ticks.store(0, std::memory_order_relaxed);
+	}
+
+	void record_push(const bool success, const size_t fill, const TickType_t blocked_ticks)
+	{
+		if(success)
+		{
+			record_fill(fill);
+		}
+		else
+		{
+			m_push_fail.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		if(blocked_ticks != 0)
+		{
+			m_push_blocked_ticks.fetch_add(blocked_ticks, std::memory_order_relaxed);
+		}
+	}
+
+	void record_pop(const bool success, const TickType_t blocked_ticks)
+	{
+		if(!success)
+		{
+			m_pop_fail.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		if(blocked_ticks != 0)
+		{
+			m_pop_blocked_ticks.fetch_add(blocked_ticks, std::memory_order_relaxed);
+		}
+	}
+
+	void record_fill(const size_t fill)
+	{
+		size_t hwm = m_high_water_mark.load(std::memory_order_relaxed);
+		while(fill > hwm)
+		{
+			if(m_high_water_mark.compare_exchange_weak(hwm, fill, std::memory_order_relaxed))
+			{
+				break;
+			}
+		}
+	}
+
+	void snapshot(Queue_stats_snapshot* const out) const
+	{
+		out->high_water_mark    = m_high_water_mark.load(std::memory_order_relaxed);
+		out->push_fail          = m_push_fail.load(std::memory_order_relaxed);
+		out->pop_fail           = m_pop_fail.load(std::memory_order_relaxed);
+		out->push_blocked_ticks = m_push_blocked_ticks.load(std::memory_order_relaxed);
+		out->pop_blocked_ticks  = m_pop_blocked_ticks.load(std::memory_order_relaxed);
+	}
+
+protected:
+
+	std::atomic<size_t> m_high_water_mark;
+
+	std::atomic<uint32_t> m_push_fail;
+	std::atomic<uint32_t> m_pop_fail;
+
+	std::atomic<TickType_t> m_push_blocked_ticks;
+	std::atomic<TickType_t> m_pop_blocked_ticks;
+};
@@ -66,6 +66,13 @@ public:
 		return pdTRUE == ret;
 	}
 
+	bool take_from_isr(BaseType_t* const pxHigherPriorityTaskWoken)
+	{
+		const BaseType_t ret = xSemaphoreTakeFromISR(m_sema, pxHigherPriorityTaskWoken);
+
+		return pdTRUE == ret;
+	}
+
 	bool give()
 	{
 		return pdTRUE == xSemaphoreGive(m_sema);
@@ -94,6 +101,11 @@ public:
 		return uxSemaphoreGetCount(m_sema);
 	}
 
+	SemaphoreHandle_t get_handle() const
+	{
+		return m_sema;
+	}
+
 protected:
 
 	SemaphoreHandle_t m_sema;
@@ -0,0 +1,378 @@
+/**
+ * @brief Stack allocated zero-copy queue for large POD objects
+ * @author Jacob Schloss <jacob@schloss.io>
+ * @copyright Copyright (c) 2026 Jacob Schloss. All rights reserved.
+ * @license Licensed under the 3-Clause BSD license. See LICENSE for details
+*/
+
+#pragma once
+
+#include "freertos_cpp_util/CSema_static.hpp"
+#include "freertos_cpp_util/Critical_section.hpp"
+#include "freertos_cpp_util/Critical_section_isr.hpp"
+
+#include "common_util/Non_copyable.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <type_traits>
+
+#include <cstdint>
+
+///
+/// Slot_queue_static
+///
+/// A FIFO of slots in our own storage, items are written and read in place and never copied
+///
+/// Producer: claim() a free slot, fill it, commit() it
+/// Consumer: read_span() one or more committed slots, use them, release() them
+///
+/// Any number of producers and consumers, slots may be committed and released out of order
+/// They are published to consumers, and recycled to producers, in FIFO order
+/// claim and read_span block like push and pop on Queue_static_pod
+///
+template<typename T, size_t LEN>
+class Slot_queue_static : private Non_copyable
+{
+public:
+
+	static_assert(std::is_pod<T>::value, "T must be POD");
+	static_assert(LEN > 0, "LEN must be non zero");
+
+	//contiguous run of slots handed to a consumer
+	struct Span
+	{
+		T* data;
+		size_t size;
+	};
+
+	Slot_queue_static() : m_free_slots(LEN, LEN), m_full_slots(LEN, 0)
+	{
+		m_claim_idx   = 0;
+		m_commit_idx  = 0;
+		m_read_idx    = 0;
+		m_release_idx = 0;
+
+		m_state.fill(SLOT_FREE);
+	}
+
+	//number of committed slots not yet read
+	size_t size() const
+	{
+		return m_full_slots.get_count();
+	}
+
+	//number of slots that can be claimed
+	size_t reserve() const
+	{
+		return m_free_slots.get_count();
+	}
+
+	size_t capacity() const
+	{
+		return LEN;
+	}
+
+	bool empty() const
+	{
+		return size() == 0;
+	}
+
+	bool full() const
+	{
+		return reserve() == 0;
+	}
+
+	//get a free slot to fill, or nullptr on timeout
+	T* claim()
+	{
+		return claim(0);
+	}
+
+	T* claim(const TickType_t xTicksToWait)
+	{
+		if(!m_free_slots.try_take_for_ticks(xTicksToWait))
+		{
+			return nullptr;
+		}
+
+		Critical_section lock;
+		return claim_slot();
+	}
+
+	template< class Rep, class Period >
+	T* claim(const std::chrono::duration<Rep,Period>& duration)
+	{
+		const std::chrono::milliseconds duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+		return claim(pdMS_TO_TICKS(duration_ms.count()));
+	}
+
+	T* claim_isr(BaseType_t* const pxHigherPriorityTaskWoken)
+	{
+		if(!m_free_slots.take_from_isr(pxHigherPriorityTaskWoken))
+		{
+			return nullptr;
+		}
+
+		Critical_section_isr lock;
+		return claim_slot();
+	}
+
+	//hand a filled slot to the consumers
+	void commit(T* const slot)
+	{
+		size_t num_published = 0;
+		{
+			Critical_section lock;
+			num_published = commit_slot(slot);
+		}
+
+		for(size_t i = 0; i < num_published; i++)
+		{
+			m_full_slots.give();
+		}
+	}
+
+	void commit_isr(T* const slot)
+	{
+		BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+		commit_isr(slot, &xHigherPriorityTaskWoken);
+
+		portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+	}
+
+	void commit_isr(T* const slot, BaseType_t* const pxHigherPriorityTaskWoken)
+	{
+		size_t num_published = 0;
+		{
+			Critical_section_isr lock;
+			num_published = commit_slot(slot);
+		}
+
+		for(size_t i = 0; i < num_published; i++)
+		{
+			m_full_slots.give_from_isr(pxHigherPriorityTaskWoken);
+		}
+	}
+
+	//get the oldest committed slot, span.size is 0 on timeout
+	Span read_span()
+	{
+		return read_span(1, 0);
+	}
+
+	Span read_span(const TickType_t xTicksToWait)
+	{
+		return read_span(1, xTicksToWait);
+	}
+
+	//get up to max_len of the oldest committed slots
+	//only waits for the first, the span stops early at the end of our storage
+	Span read_span(const size_t max_len, const TickType_t xTicksToWait)
+	{
+		Span span = {nullptr, 0};
+
+		if((max_len == 0) || !m_full_slots.try_take_for_ticks(xTicksToWait))
+		{
+			return span;
+		}
+
+		size_t num_taken = 1;
+		while((num_taken < max_len) && m_full_slots.try_take())
+		{
+			num_taken++;
+		}
+
+		{
+			Critical_section lock;
+			span = read_slots(num_taken);
+		}
+
+		//return counts for slots past the wrap
+		for(size_t i = span.size; i < num_taken; i++)
+		{
+			m_full_slots.give();
+		}
+
+		return span;
+	}
+
+	template< class Rep, class Period >
+	Span read_span(const size_t max_len, const std::chrono::duration<Rep,Period>& duration)
+	{
+		const std::chrono::milliseconds duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+		return read_span(max_len, pdMS_TO_TICKS(duration_ms.count()));
+	}
+
+	Span read_span_isr(const size_t max_len, BaseType_t* const pxHigherPriorityTaskWoken)
+	{
+		Span span = {nullptr, 0};
+
+		if((max_len == 0) || !m_full_slots.take_from_isr(pxHigherPriorityTaskWoken))
+		{
+			return span;
+		}
+
+		size_t num_taken = 1;
+		while((num_taken < max_len) && m_full_slots.take_from_isr(pxHigherPriorityTaskWoken))
+		{
+			num_taken++;
+		}
+
+		{
+			Critical_section_isr lock;
+			span = read_slots(num_taken);
+		}
+
+		for(size_t i = span.size; i < num_taken; i++)
+		{
+			m_full_slots.give_from_isr(pxHigherPriorityTaskWoken);
+		}
+
+		return span;
+	}
+
+	//return slots from read_span to the producers
+	void release(const Span& span)
+	{
+		size_t num_freed = 0;
+		{
+			Critical_section lock;
+			num_freed = release_slots(span);
+		}
+
+		for(size_t i = 0; i < num_freed; i++)
+		{
+			m_free_slots.give();
+		}
+	}
+
+	void release_isr(const Span& span)
+	{
+		BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+		release_isr(span, &xHigherPriorityTaskWoken);
+
+		portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+	}
+
+	void release_isr(const Span& span, BaseType_t* const pxHigherPriorityTaskWoken)
+	{
+		size_t num_freed = 0;
+		{
+			Critical_section_isr lock;
+			num_freed = release_slots(span);
+		}
+
+		for(size_t i = 0; i < num_freed; i++)
+		{
+			m_free_slots.give_from_isr(pxHigherPriorityTaskWoken);
+		}
+	}
+
+protected:
+
+	enum Slot_state : uint8_t
+	{
+		SLOT_FREE,
+		SLOT_CLAIMED,
+		SLOT_COMMITTED,
+		SLOT_PUBLISHED,
+		SLOT_READING,
+		SLOT_RELEASED
+	};
+
+	static size_t increment(const size_t idx)
+	{
+		return (idx + 1) == LEN ? 0 : (idx + 1);
+	}
+
+	size_t index_of(const T* const slot) const
+	{
+		return size_t(slot - m_buf.data());
+	}
+
+	//caller must hold a critical section and a m_free_slots count
+	T* claim_slot()
+	{
+		const size_t idx = m_claim_idx;
+		m_claim_idx = increment(m_claim_idx);
+
+		m_state[idx] = SLOT_CLAIMED;
+
+		return &m_buf[idx];
+	}
+
+	//caller must hold a critical section
+	//returns the number of slots now visible to consumers
+	size_t commit_slot(T* const slot)
+	{
+		m_state[index_of(slot)] = SLOT_COMMITTED;
+
+		//publish the committed run at the head, in order
+		size_t num_published = 0;
+		while(m_state[m_commit_idx] == SLOT_COMMITTED)
+		{
+			m_state[m_commit_idx] = SLOT_PUBLISHED;
+			m_commit_idx = increment(m_commit_idx);
+			num_published++;
+		}
+
+		return num_published;
+	}
+
+	//caller must hold a critical section and num m_full_slots counts
+	Span read_slots(const size_t num)
+	{
+		Span span;
+		span.data = &m_buf[m_read_idx];
+		span.size = std::min(num, LEN - m_read_idx);
+
+		for(size_t i = 0; i < span.size; i++)
+		{
+			m_state[m_read_idx] = SLOT_READING;
+			m_read_idx = increment(m_read_idx);
+		}
+
+		return span;
+	}
+
+	//caller must hold a critical section
+	//returns the number of slots now free for producers
+	size_t release_slots(const Span& span)
+	{
+		const size_t first = index_of(span.data);
+		for(size_t i = 0; i < span.size; i++)
+		{
+			m_state[first + i] = SLOT_RELEASED;
+		}
+
+		//recycle the released run at the head, in order
+		size_t num_freed = 0;
+		while(m_state[m_release_idx] == SLOT_RELEASED)
+		{
+			m_state[m_release_idx] = SLOT_FREE;
+			m_release_idx = increment(m_release_idx);
+			num_freed++;
+		}
+
+		return num_freed;
+	}
+
+	std::array<T, LEN> m_buf;
+	std::array<Slot_state, LEN> m_state;
+
+	//next slot to hand to a producer
+	size_t m_claim_idx;
+	//next slot to publish to consumers
+	size_t m_commit_idx;
+	//next slot to hand to a consumer
+	size_t m_read_idx;
+	//next slot to recycle to producers
+	size_t m_release_idx;
+
+	CSema_static m_free_slots;
+	CSema_static m_full_slots;
+};
@@ -0,0 +1,356 @@
+/**
+ * @brief Lock-free single producer single consumer queue for POD objects
+ * @author Jacob Schloss <jacob@schloss.io>
+ * @copyright Copyright (c) 2026 Jacob Schloss. All rights reserved.
+ * @license Licensed under the 3-Clause BSD license. See LICENSE for details
+*/
+
+#pragma once
+
+#include "common_util/Non_copyable.hpp"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <type_traits>
+
+///
+/// Spsc_queue
+///
+/// A ring of atomics for exactly one producer and one consumer, either of which may be an isr
+/// Same push_back / pop_front / isr interface as Queue_template_base, without a kernel queue
+/// push_front is not provided, the front belongs to the consumer
+///
+/// A blocked side is woken with a direct to task notification, only if it is actually waiting
+/// so the common path never enters the kernel
+/// The notification value of a task blocking on this queue is used, do not mix with other notification users
+///
+template<typename T, size_t LEN>
+class Spsc_queue : private Non_copyable
+{
+public:
+
+	static_assert(std::is_pod<T>::value, "T must be POD");
+	static_assert(LEN > 0, "LEN must be non zero");
+
+	Spsc_queue() : m_head(0), m_tail(0), m_pop_waiter(nullptr), m_push_waiter(nullptr)
+	{
+
+	}
+
+	//consumer only
+	void clear()
+	{
+		m_head.store(m_tail.load(std::memory_order_acquire), std::memory_order_release);
+	}
+
+	size_t size() const
+	{
+		const size_t head = m_head.load(std::memory_order_acquire);
+		const size_t tail = m_tail.load(std::memory_order_acquire);
+
+		return (tail >= head) ? (tail - head) : (BUF_LEN - head + tail);
+	}
+
+	size_t reserve() const
+	{
+		return LEN - size();
+	}
+
+	size_t capacity() const
+	{
+		return LEN;
+	}
+
+	bool full() const
+	{
+		return size() == LEN;
+	}
+
+	bool empty() const
+	{
+		return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+	}
+
+	bool pop_front(T* const item)
+	{
+		return pop_front(item, 0);
+	}
+
+	bool pop_front_wait(T* const item, const bool wait)
+	{
+		bool ret = false;
+
+		if(wait)
+		{
+			do
+			{
+				ret = pop_front(item, portMAX_DELAY);
+			} while(ret != true);
+		}
+		else
+		{
+			ret = pop_front(item, 0);
+		}
+
+		return ret;
+	}
+
+	bool pop_front(T* const item, const TickType_t xTicksToWait)
+	{
+		if(try_pop(item))
+		{
+			notify_waiter(&m_push_waiter);
+			return true;
+		}
+
+		if(xTicksToWait == 0)
+		{
+			return false;
+		}
+
+		if(!wait_for(&m_pop_waiter, xTicksToWait, [this, item](){return try_pop(item);}))
+		{
+			return false;
+		}
+
+		notify_waiter(&m_push_waiter);
+		return true;
+	}
+
+	template< class Rep, class Period >
+	bool pop_front(T* const item, const std::chrono::duration<Rep,Period>& duration)
+	{
+		const std::chrono::milliseconds duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+		return pop_front(item, pdMS_TO_TICKS(duration_ms.count()));
+	}
+
+	bool pop_front_isr(T* const item)
+	{
+		BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+		const bool ret = pop_front_isr(item, &xHigherPriorityTaskWoken);
+
+		portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+
+		return ret;
+	}
+
+	bool pop_front_isr(T* const item, BaseType_t* const pxHigherPriorityTaskWoken)
+	{
+		if(!try_pop(item))
+		{
+			return false;
+		}
+
+		notify_waiter_isr(&m_push_waiter, pxHigherPriorityTaskWoken);
+		return true;
+	}
+
+	bool push_back(const T& item)
+	{
+		return push_back(item, 0);
+	}
+
+	bool push_back_wait(const T& item, const bool wait)
+	{
+		bool ret = false;
+
+		if(wait)
+		{
+			do
+			{
+				ret = push_back(item, portMAX_DELAY);
+			} while(ret != true);
+		}
+		else
+		{
+			ret = push_back(item, 0);
+		}
+
+		return ret;
+	}
+
+	bool push_back(const T& item, const TickType_t xTicksToWait)
+	{
+		if(try_push(item))
+		{
+			notify_waiter(&m_pop_waiter);
+			return true;
+		}
+
+		if(xTicksToWait == 0)
+		{
+			return false;
+		}
+
+		if(!wait_for(&m_push_waiter, xTicksToWait, [this, &item](){return try_push(item);}))
+		{
+			return false;
+		}
+
+		notify_waiter(&m_pop_waiter);
+		return true;
+	}
+
+	template< class Rep, class Period >
+	bool push_back(const T& item, const std::chrono::duration<Rep,Period>& duration)
+	{
+		const std::chrono::milliseconds duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+		return push_back(item, pdMS_TO_TICKS(duration_ms.count()));
+	}
+
+	bool push_back_isr(const T& item)
+	{
+		BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+		const bool ret = push_back_isr(item, &xHigherPriorityTaskWoken);
+
+		portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+
+		return ret;
+	}
+
+	bool push_back_isr(const T& item, BaseType_t* const pxHigherPriorityTaskWoken)
+	{
+		if(!try_push(item))
+		{
+			return false;
+		}
+
+		notify_waiter_isr(&m_pop_waiter, pxHigherPriorityTaskWoken);
+		return true;
+	}
+
+protected:
+
+	//one slot is kept open to tell full from empty
+	static constexpr size_t BUF_LEN = LEN + 1;
+
+	static size_t increment(const size_t idx)
+	{
+		return (idx + 1) == BUF_LEN ? 0 : (idx + 1);
+	}
+
+	//producer only
+	bool try_push(const T& item)
+	{
+		const size_t tail = m_tail.load(std::memory_order_relaxed);
+		const size_t next = increment(tail);
+
+		if(next == m_head.load(std::memory_order_acquire))
+		{
+			return false;
+		}
+
+		m_buf[tail] = item;
+
+		//seq_cst, ordered before the waiter check in notify_waiter
+		m_tail.store(next, std::memory_order_seq_cst);
+
+		return true;
+	}
+
+	//consumer only
+	bool try_pop(T* const item)
+	{
+		const size_t head = m_head.load(std::memory_order_relaxed);
+
+		if(head == m_tail.load(std::memory_order_acquire))
+		{
+			return false;
+		}
+
+		*item = m_buf[head];
+
+		//seq_cst, ordered before the waiter check in notify_waiter
+		m_head.store(increment(head), std::memory_order_seq_cst);
+
+		return true;
+	}
+
+	//the waiter is only set while the other side found us empty (or full)
+	//so this only calls into the kernel on the empty to non-empty (or full to non-full) edge
+	static void notify_waiter(std::atomic<TaskHandle_t>* const waiter)
+	{
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		if(waiter->load(std::memory_order_seq_cst) == nullptr)
+		{
+			return;
+		}
+
+		TaskHandle_t task = waiter->exchange(nullptr, std::memory_order_seq_cst);
+		if(task != nullptr)
+		{
+			xTaskNotifyGive(task);
+		}
+	}
+
+	static void notify_waiter_isr(std::atomic<TaskHandle_t>* const waiter, BaseType_t* const pxHigherPriorityTaskWoken)
+	{
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		if(waiter->load(std::memory_order_seq_cst) == nullptr)
+		{
+			return;
+		}
+
+		TaskHandle_t task = waiter->exchange(nullptr, std::memory_order_seq_cst);
+		if(task != nullptr)
+		{
+			vTaskNotifyGiveFromISR(task, pxHigherPriorityTaskWoken);
+		}
+	}
+
+	//publish ourself as waiting, then retry before sleeping so a racing notify is not lost
+	//a stale notification only causes a spurious wakeup and another retry
+	template<typename Try>
+	static bool wait_for(std::atomic<TaskHandle_t>* const waiter, const TickType_t xTicksToWait, const Try& try_op)
+	{
+		TickType_t ticks_left = xTicksToWait;
+		TimeOut_t xTimeOut;
+		vTaskSetTimeOutState(&xTimeOut);
+
+		for(;;)
+		{
+			waiter->store(xTaskGetCurrentTaskHandle(), std::memory_order_seq_cst);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+
+			if(try_op())
+			{
+				waiter->store(nullptr, std::memory_order_relaxed);
+				return true;
+			}
+
+			ulTaskNotifyTake(pdTRUE, ticks_left);
+
+			waiter->store(nullptr, std::memory_order_relaxed);
+
+			if(try_op())
+			{
+				return true;
+			}
+
+			if(pdFALSE != xTaskCheckForTimeOut(&xTimeOut, &ticks_left))
+			{
+				return false;
+			}
+		}
+	}
+
+	std::array<T, BUF_LEN> m_buf;
+
+	//written by the consumer
+	std::atomic<size_t> m_head;
+	//written by the producer
+	std::atomic<size_t> m_tail;
+
+	//the task blocked in pop, if any
+	std::atomic<TaskHandle_t> m_pop_waiter;
+	//the task blocked in push, if any
+	std::atomic<TaskHandle_t> m_push_waiter;
+};
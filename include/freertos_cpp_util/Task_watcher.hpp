@@ -7,6 +7,7 @@
 
 #include "freertos_cpp_util/Task_static.hpp"
 #include "freertos_cpp_util/Task_heap.hpp"
+#include "freertos_cpp_util/Heap_frag_stats.hpp"
 #include "common_util/Stack_string.hpp"
 
 #include <array>
@@ -36,10 +37,19 @@ public:
 		m_print_handler = handler;
 	}
 
+	//optional free list walk of the heap implementation, enables the free block size histogram
+	void set_heap_walk_handler(const Heap_frag_stats::Heap_walk_func& walk)
+	{
+		m_heap_frag.set_heap_walk_handler(walk);
+	}
+
 protected:
 
 	std::function<void(const char*)> m_print_handler;
 
+	//one snapshot per watcher period, for the fragmentation trend
+	Heap_frag_stats m_heap_frag;
+
 	TaskStats taskStatus_t0;
 	TaskStats taskStatus_t1;
 };
@@ -48,6 +48,14 @@ public:
 
 	void process_one();
 
+#if FREERTOS_CPP_UTIL_OBJECT_POOL_STATS
+	//record pool use, to size NUM_RECORDS
+	void get_record_pool_stats(Object_pool_stats_snapshot* const out) const
+	{
+		m_record_pool.get_stats(out);
+	}
+#endif
+
 protected:
 
 	typedef Stack_string<8+2+1> Time_str;
@@ -11,8 +11,13 @@
 
 #include "freertos_cpp_util/object_pool/Object_pool_node.hpp"
 #include "freertos_cpp_util/object_pool/Object_pool_base.hpp"
+#include "freertos_cpp_util/object_pool/Object_pool_shared_ptr.hpp"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <new>
 #include <type_traits>
 #include <utility>
 
@@ -26,16 +31,11 @@ public:
 	using typename Object_pool_base<T>::Node_T;
 	using typename Object_pool_base<T>::Heap_element_T;
 
-	Object_pool()
+	//O(1), elements are threaded onto the free list lazily as they are first allocated
+	//so a pool in .bss costs no per element work at boot
+	Object_pool() : m_num_threaded(0)
 	{
-		for(size_t i = 0; i < LEN; i++)
-		{
-			Heap_element_T* const mem_ptr = &m_mem_node_pool[i];
-
-			mem_ptr->node = Node_T(this, reinterpret_cast<T*>( &(mem_ptr->val)) );
 
-			m_free_nodes.push_back(&mem_ptr->node);
-		}
 	}
 
 	template<class Rep, class Period, typename... Args>
@@ -49,8 +49,14 @@ public:
 	template<typename... Args>
 	T* try_allocate_for_ticks(const TickType_t xTicksToWait, Args&&... args)
 	{
-		Node_T* node = nullptr;
-		if(!m_free_nodes.pop_front(&node, xTicksToWait))
+		const TickType_t start = this->stats_start(xTicksToWait);
+
+		Node_T* node = take_fresh_node();
+		const bool ret = (node != nullptr) || m_free_nodes.pop_front(&node, xTicksToWait);
+
+		this->stats_alloc(ret, xTicksToWait, start);
+
+		if(!ret)
 		{
 			return nullptr;
 		}
@@ -61,8 +67,12 @@ public:
 	template<typename... Args>
 	T* try_allocate_isr(BaseType_t* const pxHigherPriorityTaskWoken, Args&&... args)
 	{
-		Node_T* node = nullptr;
-		if(!m_free_nodes.pop_front_isr(&node, pxHigherPriorityTaskWoken))
+		Node_T* node = take_fresh_node();
+		const bool ret = (node != nullptr) || m_free_nodes.pop_front_isr(&node, pxHigherPriorityTaskWoken);
+
+		this->stats_alloc_isr(ret);
+
+		if(!ret)
 		{
 			return nullptr;
 		}
@@ -76,31 +86,13 @@ public:
 		return try_allocate_for_ticks(0, std::forward<Args>(args)...);
 	}
 
-	class Node_T_deleter
-	{
-	public:
-		void operator()(T* ptr) const
-		{
-			Node_T* node = Node_T::get_this_from_val_ptr(ptr);
-			Object_pool_base<T>* pool = node->get_pool_ptr();
+	using typename Object_pool_base<T>::Node_T_deleter;
+	using typename Object_pool_base<T>::unique_node_ptr;
 
-			pool->deallocate(node);
-		}
-	};
-	typedef std::unique_ptr<T, Node_T_deleter> unique_node_ptr;
+	using typename Object_pool_base<T>::Node_T_deleter_isr;
+	using typename Object_pool_base<T>::isr_unique_node_ptr;
 
-	class Node_T_deleter_isr
-	{
-	public:
-		void operator()(T* ptr) const
-		{
-			Node_T* node = Node_T::get_this_from_val_ptr(ptr);
-			Object_pool_base<T>* pool = node->get_pool_ptr();
-
-			pool->deallocate_isr(node);
-		}
-	};
-	typedef std::unique_ptr<T, Node_T_deleter_isr> isr_unique_node_ptr;
+	typedef Object_pool_shared_ptr<T> shared_node_ptr;
 
 	template<typename... Args>
 	unique_node_ptr try_allocate_for_ticks_unique(const TickType_t xTicksToWait, Args&&... args)
@@ -126,6 +118,151 @@ public:
 		return isr_unique_node_ptr(val);
 	}
 
+	//reference counted in the node, no control block is allocated
+	//many readers can share one pool resident object without copies
+	template<typename... Args>
+	shared_node_ptr try_allocate_for_ticks_shared(const TickType_t xTicksToWait, Args&&... args)
+	{
+		T* val = try_allocate_for_ticks(xTicksToWait, std::forward<Args>(args)...);
+
+		return make_shared_node(val);
+	}
+
+	template<typename... Args>
+	shared_node_ptr allocate_shared(Args&&... args)
+	{
+		T* val = allocate(std::forward<Args>(args)...);
+
+		return make_shared_node(val);
+	}
+
+	template<typename... Args>
+	shared_node_ptr allocate_shared_isr(BaseType_t* const pxHigherPriorityTaskWoken, Args&&... args)
+	{
+		T* val = try_allocate_isr(pxHigherPriorityTaskWoken, std::forward<Args>(args)...);
+
+		return make_shared_node(val);
+	}
+
+	//bulk allocate, each object constructed from args
+	//best effort, blocks up to xTicksToWait for the first free node only
+	//returns the number of objects allocated into out
+	//fresh nodes are taken without the queue, recycled nodes are one queue receive each in runs of BATCH_LEN
+	template<typename... Args>
+	size_t allocate_n(T** const out, const size_t n, const TickType_t xTicksToWait, const Args&... args)
+	{
+		const TickType_t start = this->stats_start(xTicksToWait);
+
+		const size_t num = take_nodes(out, n, xTicksToWait, false);
+
+		this->stats_alloc_n(num, xTicksToWait, start);
+
+		return construct_n(out, num, args...);
+	}
+
+	//bulk allocate, all or nothing
+	//blocks up to xTicksToWait for all n, holding the nodes it already has, and returns 0 on timeout
+	template<typename... Args>
+	size_t allocate_n_all(T** const out, const size_t n, const TickType_t xTicksToWait, const Args&... args)
+	{
+		const TickType_t start = this->stats_start(xTicksToWait);
+
+		const size_t num = take_nodes(out, n, xTicksToWait, true);
+
+		this->stats_alloc_n(num, xTicksToWait, start);
+
+		return construct_n(out, num, args...);
+	}
+
+	template<typename... Args>
+	size_t allocate_n_isr(T** const out, const size_t n, BaseType_t* const pxHigherPriorityTaskWoken, const Args&... args)
+	{
+		const size_t num = take_nodes_isr(out, n, pxHigherPriorityTaskWoken, false);
+
+		this->stats_alloc_n(num, 0, 0);
+
+		return construct_n(out, num, args...);
+	}
+
+	template<typename... Args>
+	size_t allocate_n_all_isr(T** const out, const size_t n, BaseType_t* const pxHigherPriorityTaskWoken, const Args&... args)
+	{
+		const size_t num = take_nodes_isr(out, n, pxHigherPriorityTaskWoken, true);
+
+		this->stats_alloc_n(num, 0, 0);
+
+		return construct_n(out, num, args...);
+	}
+
+	//bulk deallocate, every ptr must belong to this pool
+	//the nodes go back to the front like deallocate, so the most recently freed node is reused first
+	//each node is still one queue send, batching saves the wake ups with one scheduler suspension per BATCH_LEN
+	void deallocate_n(T* const * const ptrs, const size_t n)
+	{
+		std::array<Node_T*, BATCH_LEN> batch;
+		size_t num_batch = 0;
+
+		for(size_t i = 0; i < n; i++)
+		{
+			if(ptrs[i] == nullptr)
+			{
+				continue;
+			}
+
+			Node_T* const node = Node_T::get_this_from_val_ptr(ptrs[i]);
+			node->deallocate();
+
+			this->stats_free();
+
+			batch[num_batch] = node;
+			num_batch++;
+
+			if(num_batch == BATCH_LEN)
+			{
+				m_free_nodes.push_front_n(batch.data(), num_batch, 0);
+				num_batch = 0;
+			}
+		}
+
+		if(num_batch != 0)
+		{
+			m_free_nodes.push_front_n(batch.data(), num_batch, 0);
+		}
+	}
+
+	void deallocate_n_isr(T* const * const ptrs, const size_t n, BaseType_t* const pxHigherPriorityTaskWoken)
+	{
+		std::array<Node_T*, BATCH_LEN> batch;
+		size_t num_batch = 0;
+
+		for(size_t i = 0; i < n; i++)
+		{
+			if(ptrs[i] == nullptr)
+			{
+				continue;
+			}
+
+			Node_T* const node = Node_T::get_this_from_val_ptr(ptrs[i]);
+			node->deallocate();
+
+			this->stats_free();
+
+			batch[num_batch] = node;
+			num_batch++;
+
+			if(num_batch == BATCH_LEN)
+			{
+				m_free_nodes.push_front_n_isr(batch.data(), num_batch, pxHigherPriorityTaskWoken);
+				num_batch = 0;
+			}
+		}
+
+		if(num_batch != 0)
+		{
+			m_free_nodes.push_front_n_isr(batch.data(), num_batch, pxHigherPriorityTaskWoken);
+		}
+	}
+
 	//the "best" deallocator
 	//node must belong to this pool
 	void deallocate(Node_T* const node) override
@@ -137,6 +274,8 @@ public:
 
 		node->deallocate();
 
+		this->stats_free();
+
 		// Object_pool_base<T>* pool = node->get_pool();
 		// if(pool != this)
 		// {
@@ -168,6 +307,16 @@ public:
 	//the "best" deallocator
 	//node must belong to this pool
 	void deallocate_isr(Node_T* const node) override
+	{
+		BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+		deallocate_isr(node, &xHigherPriorityTaskWoken);
+
+		portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+	}
+
+	//node must belong to this pool
+	void deallocate_isr(Node_T* const node, BaseType_t* const pxHigherPriorityTaskWoken) override
 	{
 		if(node == nullptr)
 		{
@@ -176,6 +325,8 @@ public:
 
 		node->deallocate();
 
+		this->stats_free();
+
 		// Object_pool_base<T>* pool = node->get_pool();
 		// if(pool != this)
 		// {
@@ -183,7 +334,7 @@ public:
 		// 	//that is bad
 		// }
 
-		if(!m_free_nodes.push_front_isr(node))
+		if(!m_free_nodes.push_front_isr(node, pxHigherPriorityTaskWoken))
 		{
 			//this should never fail
 			//very bad if this fails
@@ -204,10 +355,216 @@ public:
 		deallocate_isr(node);
 	}
 
+	//look up the node based on the ptr
+	//ptr must belong to this pool
+	void deallocate_isr(T* const ptr, BaseType_t* const pxHigherPriorityTaskWoken)
+	{
+		if(ptr == nullptr)
+		{
+			return;
+		}
+
+		Node_T* node = Node_T::get_this_from_val_ptr(ptr);
+		
+		deallocate_isr(node, pxHigherPriorityTaskWoken);
+	}
+
 protected:
 
+	//nodes moved per scheduler suspension in the bulk api, each node is still one queue operation
+	static constexpr size_t BATCH_LEN = 16;
+
+	//pop up to n free nodes, storing their val ptr in out
+	size_t take_nodes(T** const out, const size_t n, const TickType_t xTicksToWait, const bool all)
+	{
+		TickType_t ticks_left = xTicksToWait;
+		TimeOut_t xTimeOut;
+		vTaskSetTimeOutState(&xTimeOut);
+
+		std::array<Node_T*, BATCH_LEN> batch;
+
+		size_t num = take_fresh_nodes(out, n);
+		for(;;)
+		{
+			//take what is free now, one scheduler suspension per batch
+			while(num < n)
+			{
+				const size_t num_req = std::min(n - num, BATCH_LEN);
+				const size_t num_popped = m_free_nodes.pop_front_n(batch.data(), num_req, 0);
+
+				for(size_t i = 0; i < num_popped; i++)
+				{
+					out[num] = batch[i]->get_val_ptr();
+					num++;
+				}
+
+				if(num_popped < num_req)
+				{
+					break;
+				}
+			}
+
+			if((num == n) || (!all && (num != 0)))
+			{
+				break;
+			}
+
+			if(pdFALSE != xTaskCheckForTimeOut(&xTimeOut, &ticks_left))
+			{
+				break;
+			}
+
+			//empty, wait for the next node
+			Node_T* node = nullptr;
+			if(!m_free_nodes.pop_front(&node, ticks_left))
+			{
+				break;
+			}
+
+			out[num] = node->get_val_ptr();
+			num++;
+		}
+
+		if(all && (num != n))
+		{
+			put_nodes(out, num);
+			num = 0;
+		}
+
+		return num;
+	}
+
+	size_t take_nodes_isr(T** const out, const size_t n, BaseType_t* const pxHigherPriorityTaskWoken, const bool all)
+	{
+		std::array<Node_T*, BATCH_LEN> batch;
+
+		size_t num = take_fresh_nodes(out, n);
+		while(num < n)
+		{
+			const size_t num_req = std::min(n - num, BATCH_LEN);
+			const size_t num_popped = m_free_nodes.pop_front_n_isr(batch.data(), num_req, pxHigherPriorityTaskWoken);
+
+			for(size_t i = 0; i < num_popped; i++)
+			{
+				out[num] = batch[i]->get_val_ptr();
+				num++;
+			}
+
+			if(num_popped < num_req)
+			{
+				break;
+			}
+		}
+
+		if(all && (num != n))
+		{
+			std::array<Node_T*, BATCH_LEN> ret_batch;
+			for(size_t i = 0; i < num; i += BATCH_LEN)
+			{
+				const size_t num_ret = std::min(num - i, BATCH_LEN);
+				for(size_t j = 0; j < num_ret; j++)
+				{
+					ret_batch[j] = Node_T::get_this_from_val_ptr(out[i + j]);
+				}
+				m_free_nodes.push_front_n_isr(ret_batch.data(), num_ret, pxHigherPriorityTaskWoken);
+			}
+			num = 0;
+		}
+
+		return num;
+	}
+
+	//return unconstructed nodes taken by take_nodes
+	void put_nodes(T* const * const vals, const size_t num)
+	{
+		std::array<Node_T*, BATCH_LEN> batch;
+		for(size_t i = 0; i < num; i += BATCH_LEN)
+		{
+			const size_t num_ret = std::min(num - i, BATCH_LEN);
+			for(size_t j = 0; j < num_ret; j++)
+			{
+				batch[j] = Node_T::get_this_from_val_ptr(vals[i + j]);
+			}
+			m_free_nodes.push_front_n(batch.data(), num_ret, 0);
+		}
+	}
+
+	template<typename... Args>
+	size_t construct_n(T** const out, const size_t num, const Args&... args)
+	{
+		for(size_t i = 0; i < num; i++)
+		{
+			out[i] = Node_T::get_this_from_val_ptr(out[i])->allocate(args...);
+		}
+
+		return num;
+	}
+
+	//claim a never used element and build its node
+	//nullptr once every element has been threaded, then the free list holds all unused nodes
+	Node_T* take_fresh_node()
+	{
+		size_t idx = m_num_threaded.load(std::memory_order_relaxed);
+		do
+		{
+			if(idx >= LEN)
+			{
+				return nullptr;
+			}
+		} while(!m_num_threaded.compare_exchange_weak(idx, idx + 1, std::memory_order_relaxed));
+
+		return init_node(idx);
+	}
+
+	//claim up to n never used elements, storing their val ptr in out
+	size_t take_fresh_nodes(T** const out, const size_t n)
+	{
+		size_t idx = m_num_threaded.load(std::memory_order_relaxed);
+		size_t num = 0;
+		do
+		{
+			if(idx >= LEN)
+			{
+				return 0;
+			}
+
+			num = std::min(n, LEN - idx);
+		} while(!m_num_threaded.compare_exchange_weak(idx, idx + num, std::memory_order_relaxed));
+
+		for(size_t i = 0; i < num; i++)
+		{
+			out[i] = init_node(idx + i)->get_val_ptr();
+		}
+
+		return num;
+	}
+
+	Node_T* init_node(const size_t idx)
+	{
+		Heap_element_T* const mem_ptr = ::new(static_cast<void*>(&m_mem_node_pool[idx])) Heap_element_T;
+
+		mem_ptr->node = Node_T(this, reinterpret_cast<T*>( &(mem_ptr->val)) );
+
+		return &mem_ptr->node;
+	}
+
+	static shared_node_ptr make_shared_node(T* const val)
+	{
+		if(val != nullptr)
+		{
+			Node_T::get_this_from_val_ptr(val)->ref_init();
+		}
+
+		return shared_node_ptr(val);
+	}
+
 	//heap element: node and aligned storage
-	std::array<Heap_element_T, LEN> m_mem_node_pool;
+	//left raw until first use so the pool needs no per element construction
+	typedef std::aligned_storage_t<sizeof(Heap_element_T), alignof(Heap_element_T)> Heap_storage_T;
+	std::array<Heap_storage_T, LEN> m_mem_node_pool;
+
+	//elements [0, m_num_threaded) have been handed out at least once
+	std::atomic<size_t> m_num_threaded;
 
 	//tracks free nodes
 	Queue_static_pod<Node_T*, LEN> m_free_nodes;
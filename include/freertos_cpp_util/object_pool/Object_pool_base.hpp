@@ -8,9 +8,11 @@
 #pragma once
 
 #include "freertos_cpp_util/object_pool/Object_pool_node.hpp"
+#include "freertos_cpp_util/object_pool/Object_pool_stats.hpp"
 
 #include "common_util/Non_copyable.hpp"
 
+#include <memory>
 #include <type_traits>
 #include <utility>
 
@@ -30,6 +32,33 @@ public:
 		Node_T node;
 	};
 
+	//returns a node to whichever pool owns it
+	class Node_T_deleter
+	{
+	public:
+		void operator()(T* ptr) const
+		{
+			Node_T* node = Node_T::get_this_from_val_ptr(ptr);
+			Object_pool_base<T>* pool = node->get_pool_ptr();
+
+			pool->deallocate(node);
+		}
+	};
+	typedef std::unique_ptr<T, Node_T_deleter> unique_node_ptr;
+
+	class Node_T_deleter_isr
+	{
+	public:
+		void operator()(T* ptr) const
+		{
+			Node_T* node = Node_T::get_this_from_val_ptr(ptr);
+			Object_pool_base<T>* pool = node->get_pool_ptr();
+
+			pool->deallocate_isr(node);
+		}
+	};
+	typedef std::unique_ptr<T, Node_T_deleter_isr> isr_unique_node_ptr;
+
 	Object_pool_base() = default;
 	virtual ~Object_pool_base()
 	{
@@ -41,6 +70,7 @@ public:
 
 	virtual void deallocate_isr(T* const ptr) = 0;
 	virtual void deallocate_isr(Node_T* const node) = 0;
+	virtual void deallocate_isr(Node_T* const node, BaseType_t* const pxHigherPriorityTaskWoken) = 0;
 
 	//convinence function, if you don't know or care which pool owns it
 	//will lookup the correct pool to return to
@@ -54,6 +84,80 @@ public:
 		pool->deallocate(node);
 	}
 
+#if FREERTOS_CPP_UTIL_OBJECT_POOL_STATS
+	void get_stats(Object_pool_stats_snapshot* const out) const
+	{
+		m_stats.snapshot(out);
+	}
+
+	void reset_stats()
+	{
+		m_stats.reset();
+	}
+#endif
+
 protected:
 
+	//stats hooks, compile to nothing unless FREERTOS_CPP_UTIL_OBJECT_POOL_STATS
+	TickType_t stats_start(const TickType_t xTicksToWait) const
+	{
+#if FREERTOS_CPP_UTIL_OBJECT_POOL_STATS
+		return (xTicksToWait != 0) ? xTaskGetTickCount() : 0;
+#else
+		(void)xTicksToWait;
+		return 0;
+#endif
+	}
+
+	void stats_alloc(const bool success, const TickType_t xTicksToWait, const TickType_t start)
+	{
+#if FREERTOS_CPP_UTIL_OBJECT_POOL_STATS
+		const TickType_t wait_ticks = (xTicksToWait != 0) ? (xTaskGetTickCount() - start) : 0;
+		m_stats.record_alloc(success, wait_ticks);
+#else
+		(void)success;
+		(void)xTicksToWait;
+		(void)start;
+#endif
+	}
+
+	//bulk allocation, num objects or a failure if 0, the wait is counted once
+	void stats_alloc_n(const size_t num, const TickType_t xTicksToWait, const TickType_t start)
+	{
+#if FREERTOS_CPP_UTIL_OBJECT_POOL_STATS
+		const TickType_t wait_ticks = (xTicksToWait != 0) ? (xTaskGetTickCount() - start) : 0;
+		if(num == 0)
+		{
+			m_stats.record_alloc(false, wait_ticks);
+		}
+		for(size_t i = 0; i < num; i++)
+		{
+			m_stats.record_alloc(true, (i == 0) ? wait_ticks : 0);
+		}
+#else
+		(void)num;
+		(void)xTicksToWait;
+		(void)start;
+#endif
+	}
+
+	void stats_alloc_isr(const bool success)
+	{
+#if FREERTOS_CPP_UTIL_OBJECT_POOL_STATS
+		m_stats.record_alloc(success, 0);
+#else
+		(void)success;
+#endif
+	}
+
+	void stats_free()
+	{
+#if FREERTOS_CPP_UTIL_OBJECT_POOL_STATS
+		m_stats.record_free();
+#endif
+	}
+
+#if FREERTOS_CPP_UTIL_OBJECT_POOL_STATS
+	Object_pool_stats m_stats;
+#endif
 };
\ No newline at end of file
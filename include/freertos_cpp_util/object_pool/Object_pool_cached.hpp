@@ -0,0 +1,377 @@
+/**
+ * @brief Object_pool_cached
+ * @author Jacob Schloss <jacob@schloss.io>
+ * @copyright Copyright (c) 2026 Jacob Schloss. All rights reserved.
+ * @license Licensed under the 3-Clause BSD license. See LICENSE for details
+*/
+
+#pragma once
+
+#include "freertos_cpp_util/Core_local_section.hpp"
+#include "freertos_cpp_util/Queue_static_pod.hpp"
+
+#include "freertos_cpp_util/object_pool/Object_pool_node.hpp"
+#include "freertos_cpp_util/object_pool/Object_pool_base.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <type_traits>
+#include <utility>
+
+///
+/// Object_pool_cached
+///
+/// Same interface as Object_pool, for SMP
+/// Each core keeps a magazine of up to MAG_LEN free nodes, touched only with interrupts masked on that core
+/// An empty magazine is refilled from the shared free queue, and a full one spilled to it, MAG_LEN / 2 nodes at a time
+/// so most calls never touch the shared queue or the kernel lock
+///
+/// Set PAD to give each element its own cache line, so objects used on different cores do not false share
+///
+/// Up to (cores - 1) * MAG_LEN free nodes can sit in other cores' magazines, a blocked allocate does not see them
+/// Size LEN with that in mind, or call flush() from a task before it idles
+///
+template< typename T, size_t LEN, size_t MAG_LEN = 8, bool PAD = false >
+class Object_pool_cached : public Object_pool_base<T>
+{
+
+public:
+
+	using typename Object_pool_base<T>::Aligned_T;
+	using typename Object_pool_base<T>::Node_T;
+	using typename Object_pool_base<T>::Heap_element_T;
+
+	using typename Object_pool_base<T>::Node_T_deleter;
+	using typename Object_pool_base<T>::unique_node_ptr;
+
+	using typename Object_pool_base<T>::Node_T_deleter_isr;
+	using typename Object_pool_base<T>::isr_unique_node_ptr;
+
+	static_assert(MAG_LEN >= 2, "MAG_LEN must be at least 2");
+
+	static constexpr size_t CACHE_LINE_SIZE = 64;
+
+	Object_pool_cached()
+	{
+		for(size_t i = 0; i < LEN; i++)
+		{
+			Heap_element_T* const mem_ptr = &m_mem_node_pool[i].elem;
+
+			mem_ptr->node = Node_T(this, reinterpret_cast<T*>( &(mem_ptr->val)) );
+
+			m_free_nodes.push_back(&mem_ptr->node);
+		}
+
+		for(Magazine& mag : m_magazines)
+		{
+			mag.count = 0;
+		}
+	}
+
+	template<class Rep, class Period, typename... Args>
+	T* try_allocate_for(const std::chrono::duration<Rep,Period>& duration, Args&&... args)
+	{
+		std::chrono::milliseconds duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+
+		return try_allocate_for_ticks(pdMS_TO_TICKS(duration_ms.count()), std::forward<Args>(args)...);
+	}
+
+	template<typename... Args>
+	T* try_allocate_for_ticks(const TickType_t xTicksToWait, Args&&... args)
+	{
+		const TickType_t start = this->stats_start(xTicksToWait);
+
+		Node_T* node = get_node(xTicksToWait);
+
+		this->stats_alloc(node != nullptr, xTicksToWait, start);
+
+		if(node == nullptr)
+		{
+			return nullptr;
+		}
+
+		return node->allocate(std::forward<Args>(args)...);
+	}
+
+	template<typename... Args>
+	T* try_allocate_isr(BaseType_t* const pxHigherPriorityTaskWoken, Args&&... args)
+	{
+		Node_T* node = get_node_isr(pxHigherPriorityTaskWoken);
+
+		this->stats_alloc_isr(node != nullptr);
+
+		if(node == nullptr)
+		{
+			return nullptr;
+		}
+
+		return node->allocate(std::forward<Args>(args)...);
+	}
+
+	template<typename... Args>
+	T* allocate(Args&&... args)
+	{
+		return try_allocate_for_ticks(0, std::forward<Args>(args)...);
+	}
+
+	template<typename... Args>
+	unique_node_ptr try_allocate_for_ticks_unique(const TickType_t xTicksToWait, Args&&... args)
+	{
+		T* val = try_allocate_for_ticks(xTicksToWait, std::forward<Args>(args)...);
+
+		return unique_node_ptr(val);
+	}
+
+	template<typename... Args>
+	unique_node_ptr allocate_unique(Args&&... args)
+	{
+		T* val = allocate(std::forward<Args>(args)...);
+
+		return unique_node_ptr(val);
+	}
+
+	template<typename... Args>
+	isr_unique_node_ptr allocate_unique_isr(BaseType_t* const pxHigherPriorityTaskWoken, Args&&... args)
+	{
+		T* val = try_allocate_isr(pxHigherPriorityTaskWoken, std::forward<Args>(args)...);
+
+		return isr_unique_node_ptr(val);
+	}
+
+	//node must belong to this pool
+	void deallocate(Node_T* const node) override
+	{
+		if(node == nullptr)
+		{
+			return;
+		}
+
+		node->deallocate();
+
+		this->stats_free();
+
+		std::array<Node_T*, BATCH_LEN> batch;
+		const size_t num = put_node(node, &batch);
+		if(num != 0)
+		{
+			m_free_nodes.push_back_n(batch.data(), num, 0);
+		}
+	}
+
+	//ptr must belong to this pool
+	void deallocate(T* const ptr) override
+	{
+		if(ptr == nullptr)
+		{
+			return;
+		}
+
+		deallocate(Node_T::get_this_from_val_ptr(ptr));
+	}
+
+	//node must belong to this pool
+	void deallocate_isr(Node_T* const node) override
+	{
+		BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+		deallocate_isr(node, &xHigherPriorityTaskWoken);
+
+		portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+	}
+
+	//node must belong to this pool
+	void deallocate_isr(Node_T* const node, BaseType_t* const pxHigherPriorityTaskWoken) override
+	{
+		if(node == nullptr)
+		{
+			return;
+		}
+
+		node->deallocate();
+
+		this->stats_free();
+
+		std::array<Node_T*, BATCH_LEN> batch;
+		const size_t num = put_node(node, &batch);
+		if(num != 0)
+		{
+			m_free_nodes.push_back_n_isr(batch.data(), num, pxHigherPriorityTaskWoken);
+		}
+	}
+
+	//ptr must belong to this pool
+	void deallocate_isr(T* const ptr) override
+	{
+		if(ptr == nullptr)
+		{
+			return;
+		}
+
+		deallocate_isr(Node_T::get_this_from_val_ptr(ptr));
+	}
+
+	//ptr must belong to this pool
+	void deallocate_isr(T* const ptr, BaseType_t* const pxHigherPriorityTaskWoken)
+	{
+		if(ptr == nullptr)
+		{
+			return;
+		}
+
+		deallocate_isr(Node_T::get_this_from_val_ptr(ptr), pxHigherPriorityTaskWoken);
+	}
+
+	//return the calling core's cached nodes to the shared queue
+	void flush()
+	{
+		std::array<Node_T*, MAG_LEN> nodes;
+		size_t num = 0;
+		{
+			Core_local_section lock;
+
+			Magazine& mag = m_magazines[Core_local_section::get_core_id()];
+
+			num = mag.count;
+			std::copy_n(mag.nodes.begin(), num, nodes.begin());
+			mag.count = 0;
+		}
+
+		if(num != 0)
+		{
+			m_free_nodes.push_back_n(nodes.data(), num, 0);
+		}
+	}
+
+protected:
+
+	static constexpr size_t BATCH_LEN = MAG_LEN / 2;
+
+	static constexpr size_t ELEMENT_ALIGN = PAD ? std::max(CACHE_LINE_SIZE, alignof(Heap_element_T)) : alignof(Heap_element_T);
+
+	//Heap_element_T first, so the node lookup from a val ptr still works
+	struct alignas(ELEMENT_ALIGN) Padded_element_T
+	{
+		Heap_element_T elem;
+	};
+
+	struct alignas(CACHE_LINE_SIZE) Magazine
+	{
+		size_t count;
+		std::array<Node_T*, MAG_LEN> nodes;
+	};
+
+	//take a node from this core's magazine, nullptr if empty
+	Node_T* pop_cached()
+	{
+		Core_local_section lock;
+
+		Magazine& mag = m_magazines[Core_local_section::get_core_id()];
+		if(mag.count == 0)
+		{
+			return nullptr;
+		}
+
+		mag.count--;
+		return mag.nodes[mag.count];
+	}
+
+	//keep the first of a refill batch, cache the rest on whichever core we are now on
+	//returns the number of nodes that did not fit, moved to the front of batch
+	size_t cache_refill(Node_T** const batch, const size_t num)
+	{
+		Core_local_section lock;
+
+		Magazine& mag = m_magazines[Core_local_section::get_core_id()];
+
+		const size_t num_cached = std::min(num, MAG_LEN - mag.count);
+		std::copy_n(batch, num_cached, mag.nodes.begin() + mag.count);
+		mag.count += num_cached;
+
+		std::copy(batch + num_cached, batch + num, batch);
+		return num - num_cached;
+	}
+
+	//cache a free node, if the magazine is full move half of it out to batch
+	//returns the number of nodes to spill to the shared queue
+	size_t put_node(Node_T* const node, std::array<Node_T*, BATCH_LEN>* const batch)
+	{
+		Core_local_section lock;
+
+		Magazine& mag = m_magazines[Core_local_section::get_core_id()];
+
+		size_t num = 0;
+		if(mag.count == MAG_LEN)
+		{
+			num = BATCH_LEN;
+			mag.count -= num;
+			std::copy_n(mag.nodes.begin() + mag.count, num, batch->begin());
+		}
+
+		mag.nodes[mag.count] = node;
+		mag.count++;
+
+		return num;
+	}
+
+	Node_T* get_node(const TickType_t xTicksToWait)
+	{
+		Node_T* node = pop_cached();
+		if(node != nullptr)
+		{
+			return node;
+		}
+
+		//magazine empty, refill a batch from the shared queue, blocking for the first node if asked
+		std::array<Node_T*, BATCH_LEN> batch;
+		const size_t num = m_free_nodes.pop_front_n(batch.data(), BATCH_LEN, xTicksToWait);
+		if(num == 0)
+		{
+			return nullptr;
+		}
+
+		node = batch[num - 1];
+
+		const size_t num_left = cache_refill(batch.data(), num - 1);
+		if(num_left != 0)
+		{
+			m_free_nodes.push_back_n(batch.data(), num_left, 0);
+		}
+
+		return node;
+	}
+
+	Node_T* get_node_isr(BaseType_t* const pxHigherPriorityTaskWoken)
+	{
+		Node_T* node = pop_cached();
+		if(node != nullptr)
+		{
+			return node;
+		}
+
+		std::array<Node_T*, BATCH_LEN> batch;
+		const size_t num = m_free_nodes.pop_front_n_isr(batch.data(), BATCH_LEN, pxHigherPriorityTaskWoken);
+		if(num == 0)
+		{
+			return nullptr;
+		}
+
+		node = batch[num - 1];
+
+		const size_t num_left = cache_refill(batch.data(), num - 1);
+		if(num_left != 0)
+		{
+			m_free_nodes.push_back_n_isr(batch.data(), num_left, pxHigherPriorityTaskWoken);
+		}
+
+		return node;
+	}
+
+	//heap element: node and aligned storage, optionally one per cache line
+	std::array<Padded_element_T, LEN> m_mem_node_pool;
+
+	std::array<Magazine, Core_local_section::get_num_cores()> m_magazines;
+
+	//tracks free nodes not in a magazine
+	Queue_static_pod<Node_T*, LEN> m_free_nodes;
+};
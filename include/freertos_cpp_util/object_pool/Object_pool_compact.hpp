@@ -0,0 +1,330 @@
+/**
+ * @brief Object_pool_compact
+ * @author Jacob Schloss <jacob@schloss.io>
+ * @copyright Copyright (c) 2026 Jacob Schloss. All rights reserved.
+ * @license Licensed under the 3-Clause BSD license. See LICENSE for details
+*/
+
+#pragma once
+
+#include "freertos_cpp_util/CSema_static.hpp"
+#include "freertos_cpp_util/Critical_section.hpp"
+#include "freertos_cpp_util/Critical_section_isr.hpp"
+#include "freertos_cpp_util/object_pool/Object_pool_stats.hpp"
+
+#include "common_util/Non_copyable.hpp"
+
+#include <array>
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <cstdint>
+
+///
+/// Object_pool_compact
+///
+/// Same allocate / deallocate / unique_node_ptr interface as Object_pool, for pools of small objects
+/// There is no Object_pool_node per element, the slot is found from a T* by address arithmetic
+/// The free list is a stack of 8 bit indices for LEN < 255, or 16 bit otherwise, so bookkeeping is 1 or 2 bytes per slot
+///
+/// Free slots are counted by a counting semaphore for blocking allocation
+/// The index stack is updated in a short critical section
+///
+/// Not an Object_pool_base, so Object_pool_base<T>::free does not apply
+/// Use deallocate on the owning pool, or the unique_node_ptr which remembers it
+///
+template< typename T, size_t LEN >
+class Object_pool_compact : private Non_copyable
+{
+public:
+
+	typedef std::aligned_storage_t<sizeof(T), alignof(T)> Aligned_T;
+
+	typedef typename std::conditional<(LEN < std::numeric_limits<uint8_t>::max()), uint8_t, uint16_t>::type Index_T;
+
+	static_assert(LEN > 0, "LEN must be non zero");
+	static_assert(LEN < std::numeric_limits<uint16_t>::max(), "LEN must fit in a 16 bit index");
+
+	class Node_T_deleter
+	{
+	public:
+		Node_T_deleter() : m_pool(nullptr)
+		{
+
+		}
+
+		explicit Node_T_deleter(Object_pool_compact* const pool) : m_pool(pool)
+		{
+
+		}
+
+		void operator()(T* ptr) const
+		{
+			m_pool->deallocate(ptr);
+		}
+
+	protected:
+		Object_pool_compact* m_pool;
+	};
+	typedef std::unique_ptr<T, Node_T_deleter> unique_node_ptr;
+
+	class Node_T_deleter_isr
+	{
+	public:
+		Node_T_deleter_isr() : m_pool(nullptr)
+		{
+
+		}
+
+		explicit Node_T_deleter_isr(Object_pool_compact* const pool) : m_pool(pool)
+		{
+
+		}
+
+		void operator()(T* ptr) const
+		{
+			m_pool->deallocate_isr(ptr);
+		}
+
+	protected:
+		Object_pool_compact* m_pool;
+	};
+	typedef std::unique_ptr<T, Node_T_deleter_isr> isr_unique_node_ptr;
+
+	Object_pool_compact() : m_free_count(LEN, LEN)
+	{
+		for(size_t i = 0; i < LEN; i++)
+		{
+			m_next[i] = Index_T(i + 1);
+		}
+		m_free_head = 0;
+	}
+
+	template<class Rep, class Period, typename... Args>
+	T* try_allocate_for(const std::chrono::duration<Rep,Period>& duration, Args&&... args)
+	{
+		std::chrono::milliseconds duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+
+		return try_allocate_for_ticks(pdMS_TO_TICKS(duration_ms.count()), std::forward<Args>(args)...);
+	}
+
+	template<typename... Args>
+	T* try_allocate_for_ticks(const TickType_t xTicksToWait, Args&&... args)
+	{
+		const TickType_t start = stats_start(xTicksToWait);
+
+		if(!m_free_count.try_take_for_ticks(xTicksToWait))
+		{
+			stats_alloc(false, xTicksToWait, start);
+			return nullptr;
+		}
+
+		stats_alloc(true, xTicksToWait, start);
+
+		Index_T idx = 0;
+		{
+			Critical_section lock;
+			idx = pop_free();
+		}
+
+		return ::new(static_cast<void*>(&m_mem[idx])) T(std::forward<Args>(args)...);
+	}
+
+	template<typename... Args>
+	T* try_allocate_isr(BaseType_t* const pxHigherPriorityTaskWoken, Args&&... args)
+	{
+		if(!m_free_count.take_from_isr(pxHigherPriorityTaskWoken))
+		{
+			stats_alloc_isr(false);
+			return nullptr;
+		}
+
+		stats_alloc_isr(true);
+
+		Index_T idx = 0;
+		{
+			Critical_section_isr lock;
+			idx = pop_free();
+		}
+
+		return ::new(static_cast<void*>(&m_mem[idx])) T(std::forward<Args>(args)...);
+	}
+
+	template<typename... Args>
+	T* allocate(Args&&... args)
+	{
+		return try_allocate_for_ticks(0, std::forward<Args>(args)...);
+	}
+
+	template<typename... Args>
+	unique_node_ptr try_allocate_for_ticks_unique(const TickType_t xTicksToWait, Args&&... args)
+	{
+		T* val = try_allocate_for_ticks(xTicksToWait, std::forward<Args>(args)...);
+
+		return unique_node_ptr(val, Node_T_deleter(this));
+	}
+
+	template<typename... Args>
+	unique_node_ptr allocate_unique(Args&&... args)
+	{
+		T* val = allocate(std::forward<Args>(args)...);
+
+		return unique_node_ptr(val, Node_T_deleter(this));
+	}
+
+	template<typename... Args>
+	isr_unique_node_ptr allocate_unique_isr(BaseType_t* const pxHigherPriorityTaskWoken, Args&&... args)
+	{
+		T* val = try_allocate_isr(pxHigherPriorityTaskWoken, std::forward<Args>(args)...);
+
+		return isr_unique_node_ptr(val, Node_T_deleter_isr(this));
+	}
+
+	//ptr must belong to this pool
+	void deallocate(T* const ptr)
+	{
+		if(ptr == nullptr)
+		{
+			return;
+		}
+
+		ptr->~T();
+
+		stats_free();
+
+		{
+			Critical_section lock;
+			push_free(index_of(ptr));
+		}
+
+		m_free_count.give();
+	}
+
+	//ptr must belong to this pool
+	void deallocate_isr(T* const ptr)
+	{
+		BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+		deallocate_isr(ptr, &xHigherPriorityTaskWoken);
+
+		portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+	}
+
+	//ptr must belong to this pool
+	void deallocate_isr(T* const ptr, BaseType_t* const pxHigherPriorityTaskWoken)
+	{
+		if(ptr == nullptr)
+		{
+			return;
+		}
+
+		ptr->~T();
+
+		stats_free();
+
+		{
+			Critical_section_isr lock;
+			push_free(index_of(ptr));
+		}
+
+		m_free_count.give_from_isr(pxHigherPriorityTaskWoken);
+	}
+
+	//true if ptr points into our storage
+	bool owns(const T* const ptr) const
+	{
+		const uintptr_t addr  = reinterpret_cast<uintptr_t>(ptr);
+		const uintptr_t begin = reinterpret_cast<uintptr_t>(m_mem.data());
+		const uintptr_t end   = reinterpret_cast<uintptr_t>(m_mem.data() + LEN);
+
+		return (addr >= begin) && (addr < end);
+	}
+
+#if FREERTOS_CPP_UTIL_OBJECT_POOL_STATS
+	void get_stats(Object_pool_stats_snapshot* const out) const
+	{
+		m_stats.snapshot(out);
+	}
+
+	void reset_stats()
+	{
+		m_stats.reset();
+	}
+#endif
+
+protected:
+
+	//stats hooks, compile to nothing unless FREERTOS_CPP_UTIL_OBJECT_POOL_STATS
+	TickType_t stats_start(const TickType_t xTicksToWait) const
+	{
+#if FREERTOS_CPP_UTIL_OBJECT_POOL_STATS
+		return (xTicksToWait != 0) ? xTaskGetTickCount() : 0;
+#else
+		(void)xTicksToWait;
+		return 0;
+#endif
+	}
+
+	void stats_alloc(const bool success, const TickType_t xTicksToWait, const TickType_t start)
+	{
+#if FREERTOS_CPP_UTIL_OBJECT_POOL_STATS
+		const TickType_t wait_ticks = (xTicksToWait != 0) ? (xTaskGetTickCount() - start) : 0;
+		m_stats.record_alloc(success, wait_ticks);
+#else
+		(void)success;
+		(void)xTicksToWait;
+		(void)start;
+#endif
+	}
+
+	void stats_alloc_isr(const bool success)
+	{
+#if FREERTOS_CPP_UTIL_OBJECT_POOL_STATS
+		m_stats.record_alloc(success, 0);
+#else
+		(void)success;
+#endif
+	}
+
+	void stats_free()
+	{
+#if FREERTOS_CPP_UTIL_OBJECT_POOL_STATS
+		m_stats.record_free();
+#endif
+	}
+
+	Index_T index_of(const T* const ptr) const
+	{
+		return Index_T(reinterpret_cast<const Aligned_T*>(ptr) - m_mem.data());
+	}
+
+	//caller must hold a critical section and a m_free_count count
+	Index_T pop_free()
+	{
+		const Index_T idx = m_free_head;
+		m_free_head = m_next[idx];
+		return idx;
+	}
+
+	//caller must hold a critical section
+	void push_free(const Index_T idx)
+	{
+		m_next[idx] = m_free_head;
+		m_free_head = idx;
+	}
+
+	std::array<Aligned_T, LEN> m_mem;
+
+	//next free slot, only meaningful for free slots
+	std::array<Index_T, LEN> m_next;
+	Index_T m_free_head;
+
+	CSema_static m_free_count;
+
+#if FREERTOS_CPP_UTIL_OBJECT_POOL_STATS
+	Object_pool_stats m_stats;
+#endif
+};
@@ -0,0 +1,347 @@
+/**
+ * @brief Object_pool_lockfree
+ * @author Jacob Schloss <jacob@schloss.io>
+ * @copyright Copyright (c) 2026 Jacob Schloss. All rights reserved.
+ * @license Licensed under the 3-Clause BSD license. See LICENSE for details
+*/
+
+#pragma once
+
+#include "freertos_cpp_util/CSema_static.hpp"
+
+#include "freertos_cpp_util/object_pool/Object_pool_node.hpp"
+#include "freertos_cpp_util/object_pool/Object_pool_base.hpp"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include <cstddef>
+#include <cstdint>
+
+///
+/// Object_pool_lockfree
+///
+/// Same interface as Object_pool, the free list is a lock-free intrusive stack instead of a kernel queue
+/// Each free element stores the index of the next free element in its own unused storage
+/// The stack head is an index and an ABA tag packed in one 32 bit word, so a plain CAS works on 32 bit cores
+///
+/// allocate and deallocate are a few atomic instructions and safe from an isr
+/// A counting semaphore is only used when a task blocks on an empty pool, and only given while someone waits
+///
+template< typename T, size_t LEN >
+class Object_pool_lockfree : public Object_pool_base<T>
+{
+
+public:
+
+	using typename Object_pool_base<T>::Aligned_T;
+	using typename Object_pool_base<T>::Node_T;
+	using typename Object_pool_base<T>::Heap_element_T;
+
+	using typename Object_pool_base<T>::Node_T_deleter;
+	using typename Object_pool_base<T>::unique_node_ptr;
+
+	using typename Object_pool_base<T>::Node_T_deleter_isr;
+	using typename Object_pool_base<T>::isr_unique_node_ptr;
+
+	Object_pool_lockfree() : m_waiters(0), m_free_sema(LEN, 0)
+	{
+		for(size_t i = 0; i < LEN; i++)
+		{
+			Heap_element_T* const mem_ptr = &m_mem_node_pool[i];
+
+			mem_ptr->node = Node_T(this, reinterpret_cast<T*>( &(mem_ptr->val)) );
+
+			::new(static_cast<void*>(mem_ptr)) Link_T(uint16_t(((i + 1) < LEN) ? (i + 1) : NULL_IDX));
+		}
+
+		m_head.store(pack(0, 0), std::memory_order_relaxed);
+	}
+
+	template<class Rep, class Period, typename... Args>
+	T* try_allocate_for(const std::chrono::duration<Rep,Period>& duration, Args&&... args)
+	{
+		std::chrono::milliseconds duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+
+		return try_allocate_for_ticks(pdMS_TO_TICKS(duration_ms.count()), std::forward<Args>(args)...);
+	}
+
+	template<typename... Args>
+	T* try_allocate_for_ticks(const TickType_t xTicksToWait, Args&&... args)
+	{
+		const TickType_t start = this->stats_start(xTicksToWait);
+
+		Node_T* node = pop_free();
+
+		if((node == nullptr) && (xTicksToWait != 0))
+		{
+			node = wait_for_free(xTicksToWait);
+		}
+
+		this->stats_alloc(node != nullptr, xTicksToWait, start);
+
+		if(node == nullptr)
+		{
+			return nullptr;
+		}
+
+		return node->allocate(std::forward<Args>(args)...);
+	}
+
+	template<typename... Args>
+	T* try_allocate_isr(BaseType_t* const pxHigherPriorityTaskWoken, Args&&... args)
+	{
+		Node_T* node = pop_free();
+
+		this->stats_alloc_isr(node != nullptr);
+
+		if(node == nullptr)
+		{
+			return nullptr;
+		}
+
+		return node->allocate(std::forward<Args>(args)...);
+	}
+
+	template<typename... Args>
+	T* allocate(Args&&... args)
+	{
+		return try_allocate_for_ticks(0, std::forward<Args>(args)...);
+	}
+
+	template<typename... Args>
+	unique_node_ptr try_allocate_for_ticks_unique(const TickType_t xTicksToWait, Args&&... args)
+	{
+		T* val = try_allocate_for_ticks(xTicksToWait, std::forward<Args>(args)...);
+
+		return unique_node_ptr(val);
+	}
+
+	template<typename... Args>
+	unique_node_ptr allocate_unique(Args&&... args)
+	{
+		T* val = allocate(std::forward<Args>(args)...);
+
+		return unique_node_ptr(val);
+	}
+
+	template<typename... Args>
+	isr_unique_node_ptr allocate_unique_isr(BaseType_t* const pxHigherPriorityTaskWoken, Args&&... args)
+	{
+		T* val = try_allocate_isr(pxHigherPriorityTaskWoken, std::forward<Args>(args)...);
+
+		return isr_unique_node_ptr(val);
+	}
+
+	//node must belong to this pool
+	void deallocate(Node_T* const node) override
+	{
+		if(node == nullptr)
+		{
+			return;
+		}
+
+		node->deallocate();
+
+		this->stats_free();
+
+		push_free(node);
+
+		if(has_waiters())
+		{
+			m_free_sema.give();
+		}
+	}
+
+	//ptr must belong to this pool
+	void deallocate(T* const ptr) override
+	{
+		if(ptr == nullptr)
+		{
+			return;
+		}
+
+		deallocate(Node_T::get_this_from_val_ptr(ptr));
+	}
+
+	//node must belong to this pool
+	void deallocate_isr(Node_T* const node) override
+	{
+		BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+		deallocate_isr(node, &xHigherPriorityTaskWoken);
+
+		portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+	}
+
+	//node must belong to this pool
+	void deallocate_isr(Node_T* const node, BaseType_t* const pxHigherPriorityTaskWoken) override
+	{
+		if(node == nullptr)
+		{
+			return;
+		}
+
+		node->deallocate();
+
+		this->stats_free();
+
+		push_free(node);
+
+		if(has_waiters())
+		{
+			m_free_sema.give_from_isr(pxHigherPriorityTaskWoken);
+		}
+	}
+
+	//ptr must belong to this pool
+	void deallocate_isr(T* const ptr) override
+	{
+		if(ptr == nullptr)
+		{
+			return;
+		}
+
+		deallocate_isr(Node_T::get_this_from_val_ptr(ptr));
+	}
+
+	//ptr must belong to this pool
+	void deallocate_isr(T* const ptr, BaseType_t* const pxHigherPriorityTaskWoken)
+	{
+		if(ptr == nullptr)
+		{
+			return;
+		}
+
+		deallocate_isr(Node_T::get_this_from_val_ptr(ptr), pxHigherPriorityTaskWoken);
+	}
+
+protected:
+
+	static constexpr uint16_t NULL_IDX = std::numeric_limits<uint16_t>::max();
+
+	//next free index, lives in the storage of a free element
+	//read racily by a losing pop, so it is atomic
+	typedef std::atomic<uint16_t> Link_T;
+
+	static_assert(LEN > 0, "LEN must be non zero");
+	static_assert(LEN < NULL_IDX, "LEN must fit in a 16 bit index");
+
+	//the link sits in front of the node, in the val storage and its padding
+	static_assert(offsetof(Heap_element_T, node) >= sizeof(Link_T), "no room for the free list link");
+	static_assert(alignof(Heap_element_T) >= alignof(Link_T), "free list link is misaligned");
+
+	//head word: tag in the high half, index in the low half
+	static uint32_t pack(const uint16_t tag, const uint16_t idx)
+	{
+		return (uint32_t(tag) << 16) | uint32_t(idx);
+	}
+
+	static uint16_t get_idx(const uint32_t head)
+	{
+		return uint16_t(head & 0xFFFFU);
+	}
+
+	static uint16_t get_tag(const uint32_t head)
+	{
+		return uint16_t(head >> 16);
+	}
+
+	Link_T* get_link(const size_t idx)
+	{
+		return reinterpret_cast<Link_T*>(&m_mem_node_pool[idx]);
+	}
+
+	size_t index_of(const Node_T* const node) const
+	{
+		const Heap_element_T* const elem = reinterpret_cast<const Heap_element_T*>(node->get_val_ptr());
+		return size_t(elem - m_mem_node_pool.data());
+	}
+
+	//the tag is bumped on every pop, so a head that was popped and pushed back in between fails the CAS
+	Node_T* pop_free()
+	{
+		uint32_t head = m_head.load(std::memory_order_acquire);
+		for(;;)
+		{
+			const uint16_t idx = get_idx(head);
+			if(idx == NULL_IDX)
+			{
+				return nullptr;
+			}
+
+			const uint16_t next = get_link(idx)->load(std::memory_order_relaxed);
+			if(m_head.compare_exchange_weak(head, pack(get_tag(head) + 1, next), std::memory_order_acquire, std::memory_order_acquire))
+			{
+				return &m_mem_node_pool[idx].node;
+			}
+		}
+	}
+
+	void push_free(Node_T* const node)
+	{
+		const size_t idx = index_of(node);
+
+		Link_T* const link = ::new(static_cast<void*>(&m_mem_node_pool[idx])) Link_T(NULL_IDX);
+
+		uint32_t head = m_head.load(std::memory_order_relaxed);
+		do
+		{
+			link->store(get_idx(head), std::memory_order_relaxed);
+		} while(!m_head.compare_exchange_weak(head, pack(get_tag(head), uint16_t(idx)), std::memory_order_seq_cst, std::memory_order_relaxed));
+	}
+
+	bool has_waiters() const
+	{
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		return m_waiters.load(std::memory_order_seq_cst) != 0;
+	}
+
+	//count ourself as waiting, then retry before sleeping so a racing free is not lost
+	//a stale token only causes a spurious wakeup and another retry
+	Node_T* wait_for_free(const TickType_t xTicksToWait)
+	{
+		TickType_t ticks_left = xTicksToWait;
+		TimeOut_t xTimeOut;
+		vTaskSetTimeOutState(&xTimeOut);
+
+		Node_T* node = nullptr;
+
+		m_waiters.fetch_add(1, std::memory_order_seq_cst);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		for(;;)
+		{
+			node = pop_free();
+			if(node != nullptr)
+			{
+				break;
+			}
+
+			if(pdFALSE != xTaskCheckForTimeOut(&xTimeOut, &ticks_left))
+			{
+				break;
+			}
+
+			m_free_sema.try_take_for_ticks(ticks_left);
+		}
+		m_waiters.fetch_sub(1, std::memory_order_seq_cst);
+
+		return node;
+	}
+
+	//heap element: node and aligned storage
+	std::array<Heap_element_T, LEN> m_mem_node_pool;
+
+	std::atomic<uint32_t> m_head;
+
+	std::atomic<size_t> m_waiters;
+	CSema_static m_free_sema;
+};
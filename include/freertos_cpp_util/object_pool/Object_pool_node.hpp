@@ -10,9 +10,12 @@
 #include "freertos_cpp_util/object_pool/Object_pool_fwd.hpp"
 #include "freertos_cpp_util/object_pool/Object_pool_base.hpp"
 
+#include <atomic>
 #include <memory>
 #include <utility>
 
+#include <cstdint>
+
 template<typename T>
 class Object_pool_node
 {
@@ -21,17 +24,31 @@ public:
 
 	typedef typename Object_pool_base<T>::Heap_element_T Heap_element_T;
 
-	Object_pool_node() : m_pool_ptr(nullptr), m_val(nullptr)
+	Object_pool_node() : m_pool_ptr(nullptr), m_val(nullptr), m_ref_count(0)
 	{
 		
 	}
 
-	Object_pool_node(Object_pool_base<T>* const pool, T* const val)
+	Object_pool_node(Object_pool_base<T>* const pool, T* const val) : m_ref_count(0)
 	{
 		m_pool_ptr = pool;
 		m_val = val;
 	}
 
+	//copies the pool binding, not the reference count
+	Object_pool_node(const Object_pool_node& rhs) : m_pool_ptr(rhs.m_pool_ptr), m_val(rhs.m_val), m_ref_count(0)
+	{
+
+	}
+
+	Object_pool_node& operator=(const Object_pool_node& rhs)
+	{
+		m_pool_ptr = rhs.m_pool_ptr;
+		m_val = rhs.m_val;
+		m_ref_count.store(0, std::memory_order_relaxed);
+		return *this;
+	}
+
 	template<typename... Args>
 	T* allocate(Args&&... args)
 	{
@@ -68,10 +85,34 @@ public:
 	{
 		return m_pool_ptr;
 	}
+
+	//intrusive reference count for Object_pool_shared_ptr
+	void ref_init()
+	{
+		m_ref_count.store(1, std::memory_order_relaxed);
+	}
+
+	void ref_inc()
+	{
+		m_ref_count.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	//true if this dropped the last reference
+	bool ref_dec()
+	{
+		return m_ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1;
+	}
+
+	uint32_t get_ref_count() const
+	{
+		return m_ref_count.load(std::memory_order_relaxed);
+	}
 	
 protected:
 
 	Object_pool_base<T>* m_pool_ptr;
 	T* m_val;
+
+	std::atomic<uint32_t> m_ref_count;
 };
 
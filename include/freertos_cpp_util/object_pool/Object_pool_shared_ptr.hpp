@@ -0,0 +1,170 @@
+/**
+ * @brief Object_pool_shared_ptr
+ * @author Jacob Schloss <jacob@schloss.io>
+ * @copyright Copyright (c) 2026 Jacob Schloss. All rights reserved.
+ * @license Licensed under the 3-Clause BSD license. See LICENSE for details
+*/
+
+#pragma once
+
+#include "freertos_cpp_util/object_pool/Object_pool_node.hpp"
+#include "freertos_cpp_util/object_pool/Object_pool_base.hpp"
+
+#include "FreeRTOS.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+///
+/// Object_pool_shared_ptr
+///
+/// Shared ownership of a pool object, with the count kept in its Object_pool_node
+/// There is no control block, copies share the same pool resident object
+/// The last reference returns the node to its pool, with deallocate_isr if released in an isr
+///
+template<typename T>
+class Object_pool_shared_ptr
+{
+public:
+
+	typedef Object_pool_node<T> Node_T;
+
+	Object_pool_shared_ptr() : m_val(nullptr)
+	{
+
+	}
+
+	Object_pool_shared_ptr(std::nullptr_t) : m_val(nullptr)
+	{
+
+	}
+
+	//takes over a reference already held on val's node, see Object_pool_node::ref_init
+	explicit Object_pool_shared_ptr(T* const val) : m_val(val)
+	{
+
+	}
+
+	Object_pool_shared_ptr(const Object_pool_shared_ptr& rhs) : m_val(rhs.m_val)
+	{
+		if(m_val)
+		{
+			get_node()->ref_inc();
+		}
+	}
+
+	Object_pool_shared_ptr(Object_pool_shared_ptr&& rhs) noexcept : m_val(rhs.m_val)
+	{
+		rhs.m_val = nullptr;
+	}
+
+	~Object_pool_shared_ptr()
+	{
+		reset();
+	}
+
+	Object_pool_shared_ptr& operator=(const Object_pool_shared_ptr& rhs)
+	{
+		Object_pool_shared_ptr(rhs).swap(*this);
+		return *this;
+	}
+
+	Object_pool_shared_ptr& operator=(Object_pool_shared_ptr&& rhs) noexcept
+	{
+		Object_pool_shared_ptr(std::move(rhs)).swap(*this);
+		return *this;
+	}
+
+	void swap(Object_pool_shared_ptr& rhs) noexcept
+	{
+		std::swap(m_val, rhs.m_val);
+	}
+
+	//drop our reference
+	void reset()
+	{
+		if(m_val == nullptr)
+		{
+			return;
+		}
+
+		Node_T* const node = get_node();
+		m_val = nullptr;
+
+		if(node->ref_dec())
+		{
+			if(xPortIsInsideInterrupt() == pdTRUE)
+			{
+				node->get_pool_ptr()->deallocate_isr(node);
+			}
+			else
+			{
+				node->get_pool_ptr()->deallocate(node);
+			}
+		}
+	}
+
+	//drop our reference from an isr
+	void reset_isr(BaseType_t* const pxHigherPriorityTaskWoken)
+	{
+		if(m_val == nullptr)
+		{
+			return;
+		}
+
+		Node_T* const node = get_node();
+		m_val = nullptr;
+
+		if(node->ref_dec())
+		{
+			node->get_pool_ptr()->deallocate_isr(node, pxHigherPriorityTaskWoken);
+		}
+	}
+
+	T* get() const
+	{
+		return m_val;
+	}
+
+	T& operator*() const
+	{
+		return *m_val;
+	}
+
+	T* operator->() const
+	{
+		return m_val;
+	}
+
+	explicit operator bool() const
+	{
+		return m_val != nullptr;
+	}
+
+	uint32_t use_count() const
+	{
+		return m_val ? get_node()->get_ref_count() : 0;
+	}
+
+protected:
+
+	Node_T* get_node() const
+	{
+		return Node_T::get_this_from_val_ptr(m_val);
+	}
+
+	T* m_val;
+};
+
+template<typename T>
+bool operator==(const Object_pool_shared_ptr<T>& lhs, const Object_pool_shared_ptr<T>& rhs)
+{
+	return lhs.get() == rhs.get();
+}
+
+template<typename T>
+bool operator!=(const Object_pool_shared_ptr<T>& lhs, const Object_pool_shared_ptr<T>& rhs)
+{
+	return lhs.get() != rhs.get();
+}
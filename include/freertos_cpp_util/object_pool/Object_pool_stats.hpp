@@ -0,0 +1,117 @@
+/**
+ * @brief Object_pool runtime statistics
+ * @author Jacob Schloss <jacob@schloss.io>
+ * @copyright Copyright (c) 2026 Jacob Schloss. All rights reserved.
+ * @license Licensed under the 3-Clause BSD license. See LICENSE for details
+*/
+
+#pragma once
+
+#include "freertos_cpp_util/Critical_section.hpp"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include <atomic>
+
+#include <cstddef>
+#include <cstdint>
+
+//1 to count pool occupancy, failed allocations and wait time
+//off by default, the counters cost a few atomic updates and a tick read per blocking call
+//this changes the layout of Object_pool_base and Object_pool_compact, so set it with the FREERTOS_CPP_UTIL_OBJECT_POOL_STATS cmake option
+#ifndef FREERTOS_CPP_UTIL_OBJECT_POOL_STATS
+#define FREERTOS_CPP_UTIL_OBJECT_POOL_STATS 0
+#endif
+
+struct Object_pool_stats_snapshot
+{
+	size_t in_use;
+	size_t high_water_mark;
+
+	uint32_t alloc_fail;
+
+	TickType_t wait_ticks_total;
+	TickType_t wait_ticks_max;
+};
+
+class Object_pool_stats
+{
+public:
+
+	Object_pool_stats() : m_in_use(0), m_high_water_mark(0), m_alloc_fail(0), m_wait_ticks_total(0), m_wait_ticks_max(0)
+	{
+
+	}
+
+	//in_use is live state and is not cleared
+	void reset()
+	{
+		Critical_section lock;
+
+		m_high_water_mark.store(m_in_use.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		m_alloc_fail.store(0, std::memory_order_relaxed);
+		m_wait_ticks_total.store(0, std::memory_order_relaxed);
+		m_wait_ticks_max.store(0, std::memory_order_relaxed);
+	}
+
+	void record_alloc(const bool success, const TickType_t wait_ticks)
+	{
+		if(success)
+		{
+			const size_t in_use = m_in_use.fetch_add(1, std::memory_order_relaxed) + 1;
+			update_max(&m_high_water_mark, in_use);
+		}
+		else
+		{
+			m_alloc_fail.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		if(wait_ticks != 0)
+		{
+			m_wait_ticks_total.fetch_add(wait_ticks, std::memory_order_relaxed);
+			update_max(&m_wait_ticks_max, wait_ticks);
+		}
+	}
+
+	void record_free()
+	{
+		m_in_use.fetch_sub(1, std::memory_order_relaxed);
+	}
+
+	//all fields as one consistent set, read in a critical section so no update on this core lands part way through
+	//on an SMP port an update from another core can still land between fields
+	void snapshot(Object_pool_stats_snapshot* const out) const
+	{
+		Critical_section lock;
+
+		out->in_use           = m_in_use.load(std::memory_order_relaxed);
+		out->high_water_mark  = m_high_water_mark.load(std::memory_order_relaxed);
+		out->alloc_fail       = m_alloc_fail.load(std::memory_order_relaxed);
+		out->wait_ticks_total = m_wait_ticks_total.load(std::memory_order_relaxed);
+		out->wait_ticks_max   = m_wait_ticks_max.load(std::memory_order_relaxed);
+	}
+
+protected:
+
+	template<typename U>
+	static void update_max(std::atomic<U>* const max, const U val)
+	{
+		U cur = max->load(std::memory_order_relaxed);
+		while(val > cur)
+		{
+			if(max->compare_exchange_weak(cur, val, std::memory_order_relaxed))
+			{
+				break;
+			}
+		}
+	}
+
+	std::atomic<size_t> m_in_use;
+	std::atomic<size_t> m_high_water_mark;
+
+	std::atomic<uint32_t> m_alloc_fail;
+
+	std::atomic<TickType_t> m_wait_ticks_total;
+	std::atomic<TickType_t> m_wait_ticks_max;
+};
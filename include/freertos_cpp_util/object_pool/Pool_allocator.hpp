@@ -0,0 +1,125 @@
+/**
+ * @brief Pool_allocator
+ * @author Jacob Schloss <jacob@schloss.io>
+ * @copyright Copyright (c) 2026 Jacob Schloss. All rights reserved.
+ * @license Licensed under the 3-Clause BSD license. See LICENSE for details
+*/
+
+#pragma once
+
+#include "freertos_cpp_util/Memory_resource.hpp"
+#include "freertos_cpp_util/object_pool/Object_pool_compact.hpp"
+
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <utility>
+
+///
+/// Pool_allocator
+///
+/// C++11 style allocator for node based containers (std::list, std::map, std::set, ...)
+/// Single object allocations come from a fixed pool of LEN nodes, one static pool per rebound type
+/// so each container node type gets its own pool, and the container runs without the heap after warm up
+///
+/// An exhausted pool throws std::bad_alloc, it does not fall back to the heap
+/// Array allocations (eg unordered_map buckets) go to pvPortMalloc through FreeRTOS_memory_resource
+///
+template<typename T, size_t LEN>
+class Pool_allocator
+{
+public:
+	typedef T value_type;
+	typedef T* pointer;
+	typedef const T* const_pointer;
+	typedef T& reference;
+	typedef const T& const_reference;
+	typedef std::size_t size_type;
+	typedef std::ptrdiff_t difference_type;
+
+	//uninitialized storage for one T
+	struct Node_storage
+	{
+		Node_storage()
+		{
+
+		}
+
+		alignas(T) unsigned char data[sizeof(T)];
+	};
+
+	typedef Object_pool_compact<Node_storage, LEN> Pool_T;
+
+	Pool_allocator() noexcept
+	{
+
+	}
+
+	template<typename U>
+	Pool_allocator(const Pool_allocator<U, LEN>& rhs) noexcept
+	{
+
+	}
+
+	template<typename U>
+	struct rebind
+	{
+		typedef Pool_allocator<U, LEN> other;
+	};
+
+	size_type max_size() const noexcept
+	{
+		return std::numeric_limits<std::size_t>::max() / sizeof(T);
+	}
+
+	pointer allocate(size_type num)
+	{
+		if(num != 1)
+		{
+			if(num > max_size())
+			{
+				throw std::bad_alloc();
+			}
+
+			return static_cast<pointer>(FreeRTOS_memory_resource::get_instance()->allocate(num * sizeof(T), alignof(T)));
+		}
+
+		Node_storage* const node = get_pool()->allocate();
+		if(node == nullptr)
+		{
+			throw std::bad_alloc();
+		}
+
+		return reinterpret_cast<pointer>(node->data);
+	}
+
+	void deallocate(pointer p, size_type num)
+	{
+		if(num != 1)
+		{
+			FreeRTOS_memory_resource::get_instance()->deallocate(p, num * sizeof(T), alignof(T));
+			return;
+		}
+
+		get_pool()->deallocate(reinterpret_cast<Node_storage*>(p));
+	}
+
+	//the shared pool for this T
+	static Pool_T* get_pool()
+	{
+		static Pool_T pool;
+		return &pool;
+	}
+};
+
+template< class T1, class T2, size_t LEN >
+bool operator==(const Pool_allocator<T1, LEN>& lhs, const Pool_allocator<T2, LEN>& rhs ) noexcept
+{
+	return true;
+}
+
+template< class T1, class T2, size_t LEN >
+bool operator!=(const Pool_allocator<T1, LEN>& lhs, const Pool_allocator<T2, LEN>& rhs ) noexcept
+{
+	return false;
+}
@@ -0,0 +1,468 @@
+/**
+ * @brief Slab_allocator
+ * @author Jacob Schloss <jacob@schloss.io>
+ * @copyright Copyright (c) 2026 Jacob Schloss. All rights reserved.
+ * @license Licensed under the 3-Clause BSD license. See LICENSE for details
+*/
+
+#pragma once
+
+#include "freertos_cpp_util/object_pool/Object_pool_compact.hpp"
+
+#include "common_util/Non_copyable.hpp"
+
+#include "FreeRTOS.h"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <tuple>
+#include <utility>
+
+///
+/// Slab_class_base
+///
+/// A pool of fixed size raw blocks, one size class of a Slab_allocator
+///
+class Slab_class_base : private Non_copyable
+{
+public:
+
+	Slab_class_base(const size_t block_size, const size_t block_align, const size_t block_count) : m_block_size(block_size), m_block_align(block_align), m_block_count(block_count)
+	{
+
+	}
+
+	virtual ~Slab_class_base()
+	{
+
+	}
+
+	virtual void* allocate_block(const TickType_t xTicksToWait) = 0;
+	virtual void* allocate_block_isr(BaseType_t* const pxHigherPriorityTaskWoken) = 0;
+
+	//ptr must belong to this class
+	virtual void deallocate_block(void* const ptr) = 0;
+	virtual void deallocate_block_isr(void* const ptr, BaseType_t* const pxHigherPriorityTaskWoken) = 0;
+
+	virtual bool owns(const void* const ptr) const = 0;
+
+	size_t get_block_size() const
+	{
+		return m_block_size;
+	}
+
+	size_t get_block_align() const
+	{
+		return m_block_align;
+	}
+
+	size_t get_block_count() const
+	{
+		return m_block_count;
+	}
+
+	bool fits(const size_t size, const size_t align) const
+	{
+		return (size <= m_block_size) && (align <= m_block_align);
+	}
+
+protected:
+
+	const size_t m_block_size;
+	const size_t m_block_align;
+	const size_t m_block_count;
+};
+
+///
+/// Slab_class
+///
+/// COUNT blocks of BLOCK_SIZE bytes, each aligned to ALIGN
+///
+template<size_t BLOCK_SIZE, size_t COUNT, size_t ALIGN = alignof(std::max_align_t)>
+class Slab_class : public Slab_class_base
+{
+public:
+
+	static_assert(BLOCK_SIZE > 0, "BLOCK_SIZE must be non zero");
+	static_assert((ALIGN & (ALIGN - 1)) == 0, "ALIGN must be a power of 2");
+
+	//raw storage, the user provided constructor keeps allocation from zero filling it
+	struct Block
+	{
+		Block()
+		{
+
+		}
+
+		alignas(ALIGN) uint8_t data[BLOCK_SIZE];
+	};
+
+	static constexpr size_t BLOCK_BYTES = sizeof(Block);
+
+	Slab_class() : Slab_class_base(BLOCK_BYTES, ALIGN, COUNT)
+	{
+
+	}
+
+	void* allocate_block(const TickType_t xTicksToWait) override
+	{
+		return m_pool.try_allocate_for_ticks(xTicksToWait);
+	}
+
+	void* allocate_block_isr(BaseType_t* const pxHigherPriorityTaskWoken) override
+	{
+		return m_pool.try_allocate_isr(pxHigherPriorityTaskWoken);
+	}
+
+	void deallocate_block(void* const ptr) override
+	{
+		m_pool.deallocate(static_cast<Block*>(ptr));
+	}
+
+	void deallocate_block_isr(void* const ptr, BaseType_t* const pxHigherPriorityTaskWoken) override
+	{
+		m_pool.deallocate_isr(static_cast<Block*>(ptr), pxHigherPriorityTaskWoken);
+	}
+
+	bool owns(const void* const ptr) const override
+	{
+		return m_pool.owns(static_cast<const Block*>(ptr));
+	}
+
+#if FREERTOS_CPP_UTIL_OBJECT_POOL_STATS
+	void get_stats(Object_pool_stats_snapshot* const out) const
+	{
+		m_pool.get_stats(out);
+	}
+
+	void reset_stats()
+	{
+		m_pool.reset_stats();
+	}
+#endif
+
+protected:
+
+	Object_pool_compact<Block, COUNT> m_pool;
+};
+
+///
+/// Slab_allocator_base
+///
+/// Type erased interface to a Slab_allocator, for allocator front ends
+///
+class Slab_allocator_base : private Non_copyable
+{
+public:
+
+	virtual ~Slab_allocator_base()
+	{
+
+	}
+
+	virtual void* try_allocate_for_ticks(const size_t size, const size_t align, const TickType_t xTicksToWait) = 0;
+	virtual void* allocate_isr(const size_t size, const size_t align, BaseType_t* const pxHigherPriorityTaskWoken) = 0;
+
+	virtual void deallocate(void* const ptr) = 0;
+	virtual void deallocate_isr(void* const ptr, BaseType_t* const pxHigherPriorityTaskWoken) = 0;
+
+	virtual bool owns(const void* const ptr) const = 0;
+
+	void* allocate(const size_t size)
+	{
+		return try_allocate_for_ticks(size, alignof(std::max_align_t), 0);
+	}
+
+	void* allocate(const size_t size, const size_t align)
+	{
+		return try_allocate_for_ticks(size, align, 0);
+	}
+
+	void* try_allocate_for_ticks(const size_t size, const TickType_t xTicksToWait)
+	{
+		return try_allocate_for_ticks(size, alignof(std::max_align_t), xTicksToWait);
+	}
+
+	template<class Rep, class Period>
+	void* try_allocate_for(const size_t size, const std::chrono::duration<Rep,Period>& duration)
+	{
+		std::chrono::milliseconds duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+
+		return try_allocate_for_ticks(size, pdMS_TO_TICKS(duration_ms.count()));
+	}
+
+	void* allocate_isr(const size_t size)
+	{
+		BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+		void* const ptr = allocate_isr(size, alignof(std::max_align_t), &xHigherPriorityTaskWoken);
+
+		portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+
+		return ptr;
+	}
+
+	void deallocate_isr(void* const ptr)
+	{
+		BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+		deallocate_isr(ptr, &xHigherPriorityTaskWoken);
+
+		portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+	}
+};
+
+///
+/// Slab_allocator
+///
+/// Variable size allocation from a fixed set of Slab_class size classes, smallest first
+/// eg Slab_allocator< Slab_class<16, 32>, Slab_class<64, 16>, Slab_class<256, 4> >
+///
+/// A request is served by the smallest class that fits, or the next larger one if that class is exhausted
+/// Blocking requests only wait on the smallest class that fits
+/// Every operation is a bounded walk over the classes plus one pool operation, and there is no fragmentation
+/// deallocate finds the owning class by address range
+///
+template<typename... Classes>
+class Slab_allocator : public Slab_allocator_base
+{
+public:
+
+	static constexpr size_t NUM_CLASSES = sizeof...(Classes);
+
+	static_assert(NUM_CLASSES > 0, "need at least one size class");
+
+	Slab_allocator()
+	{
+		static_assert(classes_ascending(), "size classes must be listed smallest first");
+
+		init_classes(std::index_sequence_for<Classes...>());
+	}
+
+	using Slab_allocator_base::try_allocate_for_ticks;
+	using Slab_allocator_base::allocate_isr;
+	using Slab_allocator_base::deallocate_isr;
+
+	void* try_allocate_for_ticks(const size_t size, const size_t align, const TickType_t xTicksToWait) override
+	{
+		const size_t first = find_class(size, align);
+		if(first == NUM_CLASSES)
+		{
+			return nullptr;
+		}
+
+		for(size_t i = first; i < NUM_CLASSES; i++)
+		{
+			if(!m_classes[i]->fits(size, align))
+			{
+				continue;
+			}
+
+			void* const ptr = m_classes[i]->allocate_block(0);
+			if(ptr)
+			{
+				return ptr;
+			}
+		}
+
+		if(xTicksToWait == 0)
+		{
+			return nullptr;
+		}
+
+		return m_classes[first]->allocate_block(xTicksToWait);
+	}
+
+	void* allocate_isr(const size_t size, const size_t align, BaseType_t* const pxHigherPriorityTaskWoken) override
+	{
+		for(size_t i = find_class(size, align); i < NUM_CLASSES; i++)
+		{
+			if(!m_classes[i]->fits(size, align))
+			{
+				continue;
+			}
+
+			void* const ptr = m_classes[i]->allocate_block_isr(pxHigherPriorityTaskWoken);
+			if(ptr)
+			{
+				return ptr;
+			}
+		}
+
+		return nullptr;
+	}
+
+	//ptr must belong to this allocator
+	void deallocate(void* const ptr) override
+	{
+		Slab_class_base* const owner = find_owner(ptr);
+		if(owner)
+		{
+			owner->deallocate_block(ptr);
+		}
+	}
+
+	//ptr must belong to this allocator
+	void deallocate_isr(void* const ptr, BaseType_t* const pxHigherPriorityTaskWoken) override
+	{
+		Slab_class_base* const owner = find_owner(ptr);
+		if(owner)
+		{
+			owner->deallocate_block_isr(ptr, pxHigherPriorityTaskWoken);
+		}
+	}
+
+	bool owns(const void* const ptr) const override
+	{
+		return find_owner(ptr) != nullptr;
+	}
+
+	//largest request that can be served
+	size_t max_size() const
+	{
+		return m_classes[NUM_CLASSES - 1]->get_block_size();
+	}
+
+protected:
+
+	static constexpr bool classes_ascending()
+	{
+		const size_t sizes[] = {Classes::BLOCK_BYTES...};
+		for(size_t i = 1; i < NUM_CLASSES; i++)
+		{
+			if(sizes[i - 1] >= sizes[i])
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template<size_t... I>
+	void init_classes(std::index_sequence<I...>)
+	{
+		m_classes = {{ &std::get<I>(m_class_pools)... }};
+	}
+
+	//smallest class that fits, NUM_CLASSES if none
+	size_t find_class(const size_t size, const size_t align) const
+	{
+		for(size_t i = 0; i < NUM_CLASSES; i++)
+		{
+			if(m_classes[i]->fits(size, align))
+			{
+				return i;
+			}
+		}
+
+		return NUM_CLASSES;
+	}
+
+	Slab_class_base* find_owner(const void* const ptr) const
+	{
+		if(ptr == nullptr)
+		{
+			return nullptr;
+		}
+
+		for(size_t i = 0; i < NUM_CLASSES; i++)
+		{
+			if(m_classes[i]->owns(ptr))
+			{
+				return m_classes[i];
+			}
+		}
+
+		return nullptr;
+	}
+
+	std::tuple<Classes...> m_class_pools;
+
+	std::array<Slab_class_base*, NUM_CLASSES> m_classes;
+};
+
+///
+/// Slab_std_allocator
+///
+/// C++11 style allocator that draws from a Slab_allocator, for containers in real time paths
+/// Allocations larger than the biggest class, or with the slab exhausted, throw std::bad_alloc like FreeRTOS_allocator
+///
+template<typename T>
+class Slab_std_allocator
+{
+public:
+	typedef T value_type;
+	typedef T* pointer;
+	typedef const T* const_pointer;
+	typedef T& reference;
+	typedef const T& const_reference;
+	typedef std::size_t size_type;
+	typedef std::ptrdiff_t difference_type;
+
+	explicit Slab_std_allocator(Slab_allocator_base* const slab) noexcept : m_slab(slab)
+	{
+
+	}
+
+	template<typename U>
+	Slab_std_allocator(const Slab_std_allocator<U>& rhs) noexcept : m_slab(rhs.get_slab())
+	{
+
+	}
+
+	template<typename U>
+	struct rebind
+	{
+		typedef Slab_std_allocator<U> other;
+	};
+
+	size_type max_size() const noexcept
+	{
+		return std::numeric_limits<std::size_t>::max() / sizeof(T);
+	}
+
+	pointer allocate(size_type num)
+	{
+		if(num > max_size())
+		{
+			throw std::bad_alloc();
+		}
+
+		pointer p = static_cast<pointer>(m_slab->allocate(num * sizeof(T), alignof(T)));
+		if(p == nullptr)
+		{
+			throw std::bad_alloc();
+		}
+
+		return p;
+	}
+
+	void deallocate(pointer p, size_type num)
+	{
+		m_slab->deallocate(p);
+	}
+
+	Slab_allocator_base* get_slab() const noexcept
+	{
+		return m_slab;
+	}
+
+protected:
+	Slab_allocator_base* m_slab;
+};
+
+template< class T1, class T2 >
+bool operator==(const Slab_std_allocator<T1>& lhs, const Slab_std_allocator<T2>& rhs ) noexcept
+{
+	return lhs.get_slab() == rhs.get_slab();
+}
+
+template< class T1, class T2 >
+bool operator!=(const Slab_std_allocator<T1>& lhs, const Slab_std_allocator<T2>& rhs ) noexcept
+{
+	return !(lhs == rhs);
+}
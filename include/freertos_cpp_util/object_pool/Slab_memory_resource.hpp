@@ -0,0 +1,79 @@
+/**
+ * @brief Slab_memory_resource
+ * @author Jacob Schloss <jacob@schloss.io>
+ * @copyright Copyright (c) 2026 Jacob Schloss. All rights reserved.
+ * @license Licensed under the 3-Clause BSD license. See LICENSE for details
+*/
+
+#pragma once
+
+#include "freertos_cpp_util/object_pool/Slab_allocator.hpp"
+
+#include <memory_resource>
+#include <new>
+
+#include <cstddef>
+
+///
+/// Slab_memory_resource
+///
+/// A std::pmr::memory_resource on a Slab_allocator, so pmr containers draw from fixed size pools
+/// Requests the slab can not serve go to upstream, by default they throw std::bad_alloc
+///
+class Slab_memory_resource : public std::pmr::memory_resource
+{
+public:
+
+	explicit Slab_memory_resource(Slab_allocator_base* const slab) : m_slab(slab), m_upstream(std::pmr::null_memory_resource())
+	{
+
+	}
+
+	Slab_memory_resource(Slab_allocator_base* const slab, std::pmr::memory_resource* const upstream) : m_slab(slab), m_upstream(upstream)
+	{
+
+	}
+
+	Slab_allocator_base* get_slab() const
+	{
+		return m_slab;
+	}
+
+	std::pmr::memory_resource* upstream_resource() const
+	{
+		return m_upstream;
+	}
+
+protected:
+
+	void* do_allocate(std::size_t bytes, std::size_t alignment) override
+	{
+		void* const p = m_slab->allocate(bytes, alignment);
+		if(p != nullptr)
+		{
+			return p;
+		}
+
+		return m_upstream->allocate(bytes, alignment);
+	}
+
+	void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+	{
+		if(m_slab->owns(p))
+		{
+			m_slab->deallocate(p);
+		}
+		else
+		{
+			m_upstream->deallocate(p, bytes, alignment);
+		}
+	}
+
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+	{
+		return this == &other;
+	}
+
+	Slab_allocator_base* m_slab;
+	std::pmr::memory_resource* m_upstream;
+};
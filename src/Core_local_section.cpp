@@ -0,0 +1,7 @@
+/**
+ * @author Jacob Schloss <jacob@schloss.io>
+ * @copyright Copyright (c) 2026 Jacob Schloss. All rights reserved.
+ * @license Licensed under the 3-Clause BSD LICENSE. See License for details
+*/
+
+#include "freertos_cpp_util/Core_local_section.hpp"
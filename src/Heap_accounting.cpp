@@ -0,0 +1,232 @@
+/**
+ * @author Jacob Schloss <jacob@schloss.io>
+ * @copyright Copyright (c) 2026 Jacob Schloss. All rights reserved.
+ * @license Licensed under the 3-Clause BSD license. See LICENSE for details
+*/
+
+#include "freertos_cpp_util/Heap_accounting.hpp"
+
+#include "common_util/Non_copyable.hpp"
+
+#include <new>
+
+#if FREERTOS_CPP_UTIL_HEAP_ACCOUNTING
+
+namespace
+{
+	//Critical_section once the scheduler runs
+	//before that there is one thread, and entering a critical section would leave interrupts masked until vTaskStartScheduler
+	class Table_lock : private Non_copyable
+	{
+	public:
+		Table_lock() : m_locked(xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED)
+		{
+			if(m_locked)
+			{
+				taskENTER_CRITICAL();
+			}
+		}
+
+		~Table_lock()
+		{
+			if(m_locked)
+			{
+				taskEXIT_CRITICAL();
+			}
+		}
+
+	protected:
+		const bool m_locked;
+	};
+}
+
+std::array<Heap_task_stats, Heap_accounting::MAX_TASKS + 1> Heap_accounting::m_table;
+
+void* Heap_accounting::allocate(const size_t size)
+{
+	uint8_t* const raw_p = static_cast<uint8_t*>(pvPortMalloc(size + HEADER_SIZE));
+	if(raw_p == nullptr)
+	{
+		return nullptr;
+	}
+
+	TaskHandle_t task = nullptr;
+	if(xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED)
+	{
+		task = xTaskGetCurrentTaskHandle();
+	}
+
+	Alloc_header* const header = reinterpret_cast<Alloc_header*>(raw_p);
+	header->size = size;
+
+	{
+		Table_lock lock;
+
+		header->slot = find_slot(task);
+
+		Heap_task_stats& stats = m_table[header->slot];
+		stats.bytes += size;
+		if(stats.bytes > stats.peak_bytes)
+		{
+			stats.peak_bytes = stats.bytes;
+		}
+		stats.alloc_count++;
+	}
+
+	return raw_p + HEADER_SIZE;
+}
+
+void Heap_accounting::deallocate(void* const ptr)
+{
+	if(ptr == nullptr)
+	{
+		return;
+	}
+
+	uint8_t* const raw_p = static_cast<uint8_t*>(ptr) - HEADER_SIZE;
+	Alloc_header* const header = reinterpret_cast<Alloc_header*>(raw_p);
+
+	{
+		Table_lock lock;
+
+		m_table[header->slot].bytes -= header->size;
+	}
+
+	vPortFree(raw_p);
+}
+
+bool Heap_accounting::get_task_stats(const TaskHandle_t task, Heap_task_stats* const out_stats)
+{
+	Table_lock lock;
+
+	for(size_t i = 0; i < MAX_TASKS; i++)
+	{
+		if((m_table[i].task != nullptr) && (m_table[i].task == task))
+		{
+			*out_stats = m_table[i];
+			return true;
+		}
+	}
+
+	return false;
+}
+
+Heap_task_stats Heap_accounting::get_other_stats()
+{
+	Table_lock lock;
+
+	Heap_task_stats stats = m_table[OTHER_SLOT];
+
+	//bytes still held by deleted tasks, their slots stay claimed until these are freed
+	for(size_t i = 0; i < MAX_TASKS; i++)
+	{
+		if((m_table[i].task == nullptr) && (m_table[i].bytes != 0))
+		{
+			stats.bytes += m_table[i].bytes;
+		}
+	}
+
+	return stats;
+}
+
+void Heap_accounting::forget_task(const TaskHandle_t task)
+{
+	Table_lock lock;
+
+	for(size_t i = 0; i < MAX_TASKS; i++)
+	{
+		if((m_table[i].task != nullptr) && (m_table[i].task == task))
+		{
+			//the slot keeps its outstanding bytes, reported with the other slot, and is reused once they are freed
+			Heap_task_stats& other = m_table[OTHER_SLOT];
+			other.alloc_count += m_table[i].alloc_count;
+			m_table[i].alloc_count = 0;
+			m_table[i].task = nullptr;
+			return;
+		}
+	}
+}
+
+size_t Heap_accounting::find_slot(const TaskHandle_t task)
+{
+	if(task == nullptr)
+	{
+		return OTHER_SLOT;
+	}
+
+	size_t free_slot = OTHER_SLOT;
+	for(size_t i = 0; i < MAX_TASKS; i++)
+	{
+		if(m_table[i].task == task)
+		{
+			return i;
+		}
+
+		if((free_slot == OTHER_SLOT) && (m_table[i].task == nullptr) && (m_table[i].bytes == 0))
+		{
+			free_slot = i;
+		}
+	}
+
+	if(free_slot != OTHER_SLOT)
+	{
+		m_table[free_slot].task = task;
+		m_table[free_slot].bytes = 0;
+		m_table[free_slot].peak_bytes = 0;
+		m_table[free_slot].alloc_count = 0;
+	}
+
+	return free_slot;
+}
+
+#if FREERTOS_CPP_UTIL_HEAP_ACCOUNTING_NEW
+
+void* operator new(std::size_t size)
+{
+	void* const ptr = Heap_accounting::allocate(size);
+	if(ptr == nullptr)
+	{
+		throw std::bad_alloc();
+	}
+
+	return ptr;
+}
+
+void* operator new[](std::size_t size)
+{
+	return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+	return Heap_accounting::allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+	return Heap_accounting::allocate(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+	Heap_accounting::deallocate(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+	Heap_accounting::deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+	Heap_accounting::deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+	Heap_accounting::deallocate(ptr);
+}
+
+#endif
+
+#endif
@@ -0,0 +1,13 @@
+/**
+ * @author Jacob Schloss <jacob@schloss.io>
+ * @copyright Copyright (c) 2026 Jacob Schloss. All rights reserved.
+ * @license Licensed under the 3-Clause BSD license. See LICENSE for details
+*/
+
+#include "freertos_cpp_util/Heap_cache.hpp"
+
+Heap_cache* Heap_cache::get_instance()
+{
+	static Heap_cache instance;
+	return &instance;
+}
@@ -0,0 +1,73 @@
+/**
+ * @author Jacob Schloss <jacob@schloss.io>
+ * @copyright Copyright (c) 2026 Jacob Schloss. All rights reserved.
+ * @license Licensed under the 3-Clause BSD license. See LICENSE for details
+*/
+
+#include "freertos_cpp_util/Heap_frag_stats.hpp"
+
+void Heap_frag_stats::update()
+{
+	get_snapshot(&m_history[m_history_next], m_heap_walk);
+
+	m_history_next = (m_history_next + 1) % HISTORY_LEN;
+	if(m_history_len < HISTORY_LEN)
+	{
+		m_history_len++;
+	}
+}
+
+const Heap_frag_snapshot& Heap_frag_stats::get_latest() const
+{
+	return m_history[(m_history_next + HISTORY_LEN - 1) % HISTORY_LEN];
+}
+
+const Heap_frag_snapshot& Heap_frag_stats::get_oldest() const
+{
+	return m_history[(m_history_next + HISTORY_LEN - m_history_len) % HISTORY_LEN];
+}
+
+void Heap_frag_stats::get_snapshot(Heap_frag_snapshot* const out_snap, const Heap_walk_func& walk)
+{
+	HeapStats_t stat;
+	vPortGetHeapStats(&stat);
+
+	out_snap->free_bytes          = stat.xAvailableHeapSpaceInBytes;
+	out_snap->min_ever_free_bytes = stat.xMinimumEverFreeBytesRemaining;
+	out_snap->largest_free_block  = stat.xSizeOfLargestFreeBlockInBytes;
+	out_snap->smallest_free_block = stat.xSizeOfSmallestFreeBlockInBytes;
+	out_snap->num_free_blocks     = stat.xNumberOfFreeBlocks;
+
+	out_snap->histogram.fill(0);
+	out_snap->has_histogram = bool(walk);
+	if(walk)
+	{
+		walk([out_snap](const size_t block_size)
+			{
+				out_snap->histogram[get_bin(block_size)]++;
+			}
+		);
+	}
+
+	if(out_snap->free_bytes == 0)
+	{
+		out_snap->frag_index = 0.0f;
+	}
+	else
+	{
+		out_snap->frag_index = 1.0f - float(out_snap->largest_free_block) / float(out_snap->free_bytes);
+	}
+}
+
+size_t Heap_frag_stats::get_bin(const size_t block_size)
+{
+	size_t bin = 0;
+	size_t bin_max = Heap_frag_snapshot::MIN_BIN_SIZE;
+	while((bin < (Heap_frag_snapshot::NUM_BINS - 1)) && (block_size >= bin_max))
+	{
+		bin++;
+		bin_max <<= 1;
+	}
+
+	return bin;
+}
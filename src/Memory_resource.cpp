@@ -0,0 +1,13 @@
+/**
+ * @author Jacob Schloss <jacob@schloss.io>
+ * @copyright Copyright (c) 2026 Jacob Schloss. All rights reserved.
+ * @license Licensed under the 3-Clause BSD license. See LICENSE for details
+*/
+
+#include "freertos_cpp_util/Memory_resource.hpp"
+
+FreeRTOS_memory_resource* FreeRTOS_memory_resource::get_instance()
+{
+	static FreeRTOS_memory_resource instance;
+	return &instance;
+}
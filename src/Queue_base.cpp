@@ -6,12 +6,29 @@
 
 #include "freertos_cpp_util/Queue_base.hpp"
 
-Queue_base::Queue_base()
+#include "freertos_cpp_util/Critical_section.hpp"
+
+#include <cstring>
+
+#if FREERTOS_CPP_UTIL_QUEUE_STATS
+Queue_handle* Queue_handle::m_stats_head = nullptr;
+#endif
+
+Queue_handle::Queue_handle()
 {
 	m_queue = nullptr;
+
+#if FREERTOS_CPP_UTIL_QUEUE_STATS
+	m_stats_name = nullptr;
+	m_stats_next = nullptr;
+#endif
 }
-Queue_base::~Queue_base()
+Queue_handle::~Queue_handle()
 {
+#if FREERTOS_CPP_UTIL_QUEUE_STATS
+	unregister_stats();
+#endif
+
 	if(m_queue)
 	{
 		//if we've been named, remove us
@@ -24,4 +41,85 @@ Queue_base::~Queue_base()
 		vQueueDelete(m_queue);
 		m_queue = nullptr;
 	}
-}
\ No newline at end of file
+}
+
+#if FREERTOS_CPP_UTIL_QUEUE_STATS
+void Queue_handle::register_stats(const char* name)
+{
+	Critical_section lock;
+
+	//only link once, renaming just updates the name
+	if(m_stats_name == nullptr)
+	{
+		m_stats_next = m_stats_head;
+		m_stats_head = this;
+	}
+
+	m_stats_name = name;
+}
+
+void Queue_handle::unregister_stats()
+{
+	if(m_stats_name == nullptr)
+	{
+		return;
+	}
+
+	Critical_section lock;
+
+	Queue_handle** link = &m_stats_head;
+	while(*link)
+	{
+		if(*link == this)
+		{
+			*link = m_stats_next;
+			break;
+		}
+
+		link = &((*link)->m_stats_next);
+	}
+
+	m_stats_name = nullptr;
+	m_stats_next = nullptr;
+}
+
+bool Queue_handle::get_stats_by_name(const char* name, Queue_stats_snapshot* const out)
+{
+	Critical_section lock;
+
+	for(Queue_handle* q = m_stats_head; q != nullptr; q = q->m_stats_next)
+	{
+		if(strcmp(q->m_stats_name, name) == 0)
+		{
+			out->name = q->m_stats_name;
+			q->m_stats.snapshot(out);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void Queue_handle::for_each_stats(const std::function<void(const Queue_stats_snapshot&)>& func)
+{
+	Suspend_task_scheduler lock;
+
+	for(Queue_handle* q = m_stats_head; q != nullptr; q = q->m_stats_next)
+	{
+		Queue_stats_snapshot snap;
+		snap.name = q->m_stats_name;
+		q->m_stats.snapshot(&snap);
+
+		func(snap);
+	}
+}
+#endif
+
+Queue_base::Queue_base()
+{
+
+}
+Queue_base::~Queue_base()
+{
+
+}
@@ -6,6 +6,8 @@
 
 #include "freertos_cpp_util/Task_base.hpp"
 
+#include "freertos_cpp_util/Heap_accounting.hpp"
+
 extern "C"
 {
 	void FreeRTOS_task_dispatch(void* ctx)
@@ -32,6 +34,11 @@ Task_base::~Task_base()
 {
 	if(m_handle)
 	{
+#if FREERTOS_CPP_UTIL_HEAP_ACCOUNTING
+		//free the accounting slot before the handle can be reused by a new task
+		Heap_accounting::forget_task(m_handle);
+#endif
+
 		vTaskDelete(m_handle);
 		m_handle = nullptr;
 	}
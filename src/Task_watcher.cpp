@@ -7,6 +7,8 @@
 
 #include "freertos_cpp_util/Task_watcher.hpp"
 
+#include "freertos_cpp_util/Heap_accounting.hpp"
+
 void Task_watcher::work()
 {
 	const size_t dt_ms       = 5000;
@@ -51,9 +53,13 @@ UBaseType_t Task_watcher::getTaskStats(TaskStatusArray* const pxTaskStatusArray,
 
 bool Task_watcher::calcStats(size_t num_task_0, const TaskStats& t0, size_t num_task_1, const TaskStats& t1)
 {
-	Stack_string<512> out_msg;
+	Stack_string<1024> out_msg;
 
+#if FREERTOS_CPP_UTIL_HEAP_ACCOUNTING
+	out_msg.sprintf("Name\tNum\tState\tHWM\tRT\tHeap\tPeak\tAllocs\r\n");
+#else
 	out_msg.sprintf("Name\tNum\tState\tHWM\tRT\r\n");
+#endif
 
 	const float dt_ms = float(t1.runTimeSinceBoot - t0.runTimeSinceBoot) / 1000.0f;
 
@@ -66,6 +72,21 @@ bool Task_watcher::calcStats(size_t num_task_0, const TaskStats& t0, size_t num_
 			const unsigned long dt_runtime = task_t1->ulRunTimeCounter - task_t0->ulRunTimeCounter;
 			const float task_percent_cpu = 100.0f * (float(dt_runtime) / 1000.0f) / dt_ms;
 
+#if FREERTOS_CPP_UTIL_HEAP_ACCOUNTING
+			Heap_task_stats heap_stats = {};
+			Heap_accounting::get_task_stats(task_t1->xHandle, &heap_stats);
+
+			out_msg.sprintf("%s\t%u\t%s\t%u\t%.2f\t%u\t%u\t%u\r\n",
+				task_t1->pcTaskName,
+				unsigned(task_t1->xTaskNumber),
+				task_state_to_str(task_t1->eCurrentState),
+				unsigned(task_t1->usStackHighWaterMark),
+				task_percent_cpu,
+				unsigned(heap_stats.bytes),
+				unsigned(heap_stats.peak_bytes),
+				unsigned(heap_stats.alloc_count)
+			);
+#else
 			out_msg.sprintf("%s\t%u\t%s\t%u\t%.2f\r\n",
 				task_t1->pcTaskName,
 				unsigned(task_t1->xTaskNumber),
@@ -73,18 +94,63 @@ bool Task_watcher::calcStats(size_t num_task_0, const TaskStats& t0, size_t num_
 				unsigned(task_t1->usStackHighWaterMark),
 				task_percent_cpu
 			);
+#endif
 		}
 	}
 
+#if FREERTOS_CPP_UTIL_HEAP_ACCOUNTING
+	{
+		//boot time, deleted and untracked tasks
+		const Heap_task_stats heap_stats = Heap_accounting::get_other_stats();
+
+		out_msg.sprintf("Other\t\t\t\t\t%u\t%u\t%u\r\n",
+			unsigned(heap_stats.bytes),
+			unsigned(heap_stats.peak_bytes),
+			unsigned(heap_stats.alloc_count)
+		);
+	}
+#endif
+
 	{
-		HeapStats_t stat;
-		vPortGetHeapStats(&stat);
+		m_heap_frag.update();
+
+		const Heap_frag_snapshot& snap = m_heap_frag.get_latest();
 
 		out_msg.sprintf("Heap Stats\r\n\tSize: %u\r\n\tAvail: %u\r\n\tMinAvail: %u\r\n",
 			unsigned(configTOTAL_HEAP_SIZE),
-			unsigned(stat.xAvailableHeapSpaceInBytes),
-			unsigned(stat.xMinimumEverFreeBytesRemaining)
+			unsigned(snap.free_bytes),
+			unsigned(snap.min_ever_free_bytes)
+		);
+
+		out_msg.sprintf("\tLargest: %u\r\n\tSmallest: %u\r\n\tFreeBlocks: %u\r\n\tFrag: %.1f%%\r\n",
+			unsigned(snap.largest_free_block),
+			unsigned(snap.smallest_free_block),
+			unsigned(snap.num_free_blocks),
+			100.0f * snap.frag_index
 		);
+
+		if(snap.has_histogram)
+		{
+			out_msg.sprintf("\tHist:");
+			for(size_t i = 0; i < Heap_frag_snapshot::NUM_BINS; i++)
+			{
+				out_msg.sprintf(" %u+:%u", unsigned(Heap_frag_stats::get_bin_min(i)), unsigned(snap.histogram[i]));
+			}
+			out_msg.sprintf("\r\n");
+		}
+
+		//change since the oldest snapshot in the window
+		if(m_heap_frag.get_history_len() > 1)
+		{
+			const Heap_frag_snapshot& old_snap = m_heap_frag.get_oldest();
+
+			out_msg.sprintf("\tTrend (%u periods): Frag %+.1f%%, Largest %+d, FreeBlocks %+d\r\n",
+				unsigned(m_heap_frag.get_history_len() - 1),
+				100.0f * (snap.frag_index - old_snap.frag_index),
+				int(snap.largest_free_block) - int(old_snap.largest_free_block),
+				int(snap.num_free_blocks) - int(old_snap.num_free_blocks)
+			);
+		}
 	}
 	
 	if(out_msg.full())